@@ -0,0 +1,441 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "InputGenerator/RegexGenerator.h"
+#include "Objects/BackRefRegex.h"
+#include "Objects/BitParallelMatcher.h"
+#include "Objects/BitsetSimulator.h"
+#include "Objects/BrzozowskiDFA.h"
+#include "Objects/FiniteAutomaton.h"
+#include "Objects/Language.h"
+#include "Objects/LazyDFA.h"
+#include "Objects/MatchSearcher.h"
+#include "Objects/Regex.h"
+#include "Objects/StreamMatcher.h"
+#include "Objects/TransformationMonoid.h"
+
+using std::cout;
+using std::string;
+using std::vector;
+
+struct Benchmark {
+	string name;
+	// подготовка входных данных не входит в замер
+	std::function<std::function<void()>()> prepare;
+};
+
+// регулярки заданной сложности от RegexGenerator
+vector<string> generate_regexes(int count, int regex_length, int star_num, int star_nesting,
+								int alphabet_size) {
+	RegexGenerator generator(regex_length, star_num, star_nesting, alphabet_size);
+	vector<string> regexes;
+	for (int i = 0; i < count; i++)
+		regexes.push_back(generator.generate_regex());
+	return regexes;
+}
+
+vector<FiniteAutomaton> thompson_automata(const vector<string>& regexes) {
+	vector<FiniteAutomaton> automata;
+	for (const auto& regex : regexes)
+		automata.push_back(Regex(regex).to_thompson());
+	return automata;
+}
+
+// определизация автоматов Томпсона: короткие регулярки, длинные с глубокой вложенностью звезд
+// и регулярки над большим алфавитом
+std::function<void()> determinize_workload(int count, int regex_length, int star_num,
+										   int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>(thompson_automata(
+		generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size)));
+	return [automata]() {
+		for (const auto& fa : *automata)
+			fa.determinize();
+	};
+}
+
+// удаление eps-переходов из автоматов Томпсона обоими способами
+std::function<void()> remove_eps_workload(int count, int regex_length, int star_num,
+										  int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>(thompson_automata(
+		generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size)));
+	return [automata]() {
+		for (const auto& fa : *automata) {
+			fa.remove_eps();
+			fa.remove_eps_additional();
+		}
+	};
+}
+
+// численная оценка неоднозначности автоматов Глушкова: подсчёт путей длинными целыми и
+// разности дробей
+std::function<void()> ambiguity_workload(int count, int regex_length, int star_num,
+										 int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>();
+	for (const auto& regex :
+		 generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size))
+		automata->push_back(Regex(regex).to_glushkov());
+	return [automata]() {
+		for (const auto& fa : *automata)
+			fa.ambiguity();
+	};
+}
+
+// структурная классификация неоднозначности автоматов Глушкова (EDA/IDA)
+std::function<void()> structural_ambiguity_workload(int count, int regex_length, int star_num,
+													int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>();
+	for (const auto& regex :
+		 generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size))
+		automata->push_back(Regex(regex).to_glushkov());
+	return [automata]() {
+		for (const auto& fa : *automata)
+			fa.structural_ambiguity();
+	};
+}
+
+// минимизация ДКА, полученных определизацией автоматов Томпсона
+std::function<void()> minimize_workload(int count, int regex_length, int star_num,
+										int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>();
+	for (const auto& fa : thompson_automata(
+			 generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size)))
+		automata->push_back(fa.determinize());
+	return [automata]() {
+		for (const auto& dfa : *automata)
+			dfa.minimize();
+	};
+}
+
+// построение моноида переходов минимальных ДКА
+std::function<void()> transformation_monoid_workload(int count, int regex_length, int star_num,
+													 int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>();
+	for (const auto& fa : thompson_automata(
+			 generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size)))
+		automata->push_back(fa.minimize());
+	return [automata]() {
+		for (const auto& dfa : *automata)
+			TransformationMonoid(dfa).class_card();
+	};
+}
+
+// нижняя оценка Глейстера-Шаллита для автоматов Глушкова регулярок с большими таблицами
+// Майхилла-Нерода
+std::function<void()> glaister_shallit_workload() {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>();
+	for (const auto& regex : {"(aa|b)*(ab|ba)*(a|bb)*",
+							  "(ab|ba)*(abb|bba)*a",
+							  "(ab|ba|aab)*(abb|bba)*(a|ba)*",
+							  "(a|b)*a(a|b)(a|b)(a|b)(a|b)(a|b)"})
+		automata->push_back(Regex(regex).to_glushkov());
+	return [automata]() {
+		for (const auto& fa : *automata)
+			fa.get_classes_number_GlaisterShallit();
+	};
+}
+
+// разбор длинных регулярок с глубокой вложенностью скобок в Regex и BackRefRegex
+std::function<void()> parse_regex_workload(int count, int regex_length, int star_num,
+										   int star_nesting, int alphabet_size) {
+	auto regexes = std::make_shared<vector<string>>(
+		generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size));
+	return [regexes]() {
+		for (const auto& regex : *regexes) {
+			Regex r(regex);
+			BackRefRegex br(regex);
+		}
+	};
+}
+
+// автоматы Антимирова: частные производные создают и удаляют множество нод регулярок
+std::function<void()> antimirov_workload(int count, int regex_length, int star_num,
+										 int star_nesting, int alphabet_size) {
+	auto regexes = std::make_shared<vector<Regex>>();
+	for (const auto& regex :
+		 generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size))
+		regexes->emplace_back(regex);
+	return [regexes]() {
+		for (const auto& regex : *regexes)
+			regex.to_antimirov();
+	};
+}
+
+// регулярки по минимальным ДКА методом Ардена: выражения СЛАУ растут подстановками
+std::function<void()> arden_workload(int count, int regex_length, int star_num,
+									 int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>();
+	for (const auto& fa : thompson_automata(
+			 generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size)))
+		automata->push_back(fa.minimize());
+	return [automata]() {
+		for (const auto& dfa : *automata)
+			dfa.to_regex();
+	};
+}
+
+// объединение бисимилярных состояний автоматов Томпсона
+std::function<void()> merge_bisimilar_workload(int count, int regex_length, int star_num,
+											   int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>(thompson_automata(
+		generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size)));
+	return [automata]() {
+		for (const auto& fa : *automata)
+			fa.merge_bisimilar();
+	};
+}
+
+// проверка вложенности языков пар автоматов Илие-Ю
+std::function<void()> subset_workload(int count, int regex_length, int star_num,
+									  int star_nesting, int alphabet_size) {
+	vector<string> regexes =
+		generate_regexes(2 * count, regex_length, star_num, star_nesting, alphabet_size);
+	auto automata = std::make_shared<vector<FiniteAutomaton>>();
+	for (const auto& regex : regexes)
+		automata->push_back(Regex(regex).to_ilieyu());
+	return [automata]() {
+		for (int i = 0; i + 1 < automata->size(); i += 2) {
+			(*automata)[i].subset((*automata)[i + 1]);
+			(*automata)[i + 1].subset((*automata)[i]);
+		}
+	};
+}
+
+// проверка эквивалентности автоматов Томпсона и Глушкова одной регулярки
+std::function<void()> equivalent_workload(int count, int regex_length, int star_num,
+										  int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<std::pair<FiniteAutomaton, FiniteAutomaton>>>();
+	for (const auto& regex :
+		 generate_regexes(count, regex_length, star_num, star_nesting, alphabet_size))
+		automata->emplace_back(Regex(regex).to_thompson(), Regex(regex).to_glushkov());
+	return [automata]() {
+		for (const auto& [fa1, fa2] : *automata)
+			FiniteAutomaton::equivalent(fa1, fa2);
+	};
+}
+
+// пересечение, объединение и разность пар автоматов Томпсона
+std::function<void()> product_workload(int count, int regex_length, int star_num,
+									   int star_nesting, int alphabet_size) {
+	auto automata = std::make_shared<vector<FiniteAutomaton>>(thompson_automata(
+		generate_regexes(2 * count, regex_length, star_num, star_nesting, alphabet_size)));
+	return [automata]() {
+		for (int i = 0; i + 1 < automata->size(); i += 2) {
+			FiniteAutomaton::intersection((*automata)[i], (*automata)[i + 1]);
+			FiniteAutomaton::uunion((*automata)[i], (*automata)[i + 1]);
+			FiniteAutomaton::difference((*automata)[i], (*automata)[i + 1]);
+		}
+	};
+}
+
+// разбор симуляцией НКА: неоднозначные автоматы Томпсона, на которых parse работает
+// экспоненциально долго, и длинные слова
+std::function<void()> parse_bitset_workload(int word_length) {
+	auto simulators = std::make_shared<vector<BitsetSimulator>>();
+	for (const auto& fa :
+		 thompson_automata({"(a|a)*b", "(a*)*b", "((a|b)*(a|b)*)*c", "(a|ab|b)*(a|b)*"}))
+		simulators->emplace_back(fa);
+	auto words = std::make_shared<vector<string>>();
+	words->push_back(string(word_length, 'a'));
+	words->push_back(string(word_length, 'a') + "b");
+	string ab;
+	for (int i = 0; i < word_length / 2; i++)
+		ab += "ab";
+	words->push_back(ab);
+	return [simulators, words]() {
+		for (const auto& simulator : *simulators)
+			for (const auto& word : *words)
+				simulator.parse(word);
+	};
+}
+
+// разбор ленивым ДКА: автомат Томпсона для (a|b)*a(a|b)^k, полный ДКА которого содержит
+// 2^(k+1) состояний, и серия случайных слов
+std::function<void()> lazy_dfa_workload(int k, int words_number, int word_length) {
+	string regex = "(a|b)*a";
+	for (int i = 0; i < k; i++)
+		regex += "(a|b)";
+	auto fa = std::make_shared<FiniteAutomaton>(Regex(regex).to_thompson());
+	auto words = std::make_shared<vector<string>>();
+	std::mt19937 rng(0);
+	for (int i = 0; i < words_number; i++) {
+		string word;
+		for (int j = 0; j < word_length; j++)
+			word += static_cast<char>('a' + rng() % 2);
+		words->push_back(word);
+	}
+	return [fa, words]() {
+		LazyDFA dfa(*fa);
+		for (const auto& word : *words)
+			dfa.parse(word);
+	};
+}
+
+// разбор случайных слов ДКА Бжозовского, который строится прямо по регулярке; вариант с
+// отрицанием проверяет слова вне языка (a|b)*a(a|b)^k
+std::function<void()> brzozowski_workload(int k, bool negative, int words_number,
+										  int word_length) {
+	string regex = "(a|b)*a";
+	for (int i = 0; i < k; i++)
+		regex += "(a|b)";
+	if (negative)
+		regex = "^(" + regex + ")";
+	auto regex_ptr = std::make_shared<Regex>(regex);
+	auto words = std::make_shared<vector<string>>();
+	std::mt19937 rng(0);
+	for (int i = 0; i < words_number; i++) {
+		string word;
+		for (int j = 0; j < word_length; j++)
+			word += static_cast<char>('a' + rng() % 2);
+		words->push_back(word);
+	}
+	return [regex_ptr, words]() {
+		BrzozowskiDFA dfa(*regex_ptr);
+		for (const auto& word : *words)
+			dfa.parse(word);
+	};
+}
+
+// битово-параллельный разбор по позициям Глушкова: до 64 позиций и несколько сотен позиций.
+// Регулярки вида (r|a|b)*, чтобы разбор длинного слова не обрывался
+std::function<void()> bitparallel_workload(int count, int regex_length, int star_num,
+										   int star_nesting, int word_length) {
+	auto matchers = std::make_shared<vector<BitParallelMatcher>>();
+	for (const auto& regex : generate_regexes(count, regex_length, star_num, star_nesting, 2))
+		matchers->push_back(Regex("(" + regex + "|a|b)*").compile_bitparallel());
+	auto word = std::make_shared<string>();
+	std::mt19937 rng(0);
+	for (int i = 0; i < word_length; i++)
+		*word += static_cast<char>('a' + rng() % 2);
+	return [matchers, word]() {
+		for (const auto& matcher : *matchers)
+			matcher.parse(*word);
+	};
+}
+
+// пакетный разбор случайных слов по плоской таблице ДКА языка (a|b)*a(a|b)^tail_length; при
+// большом tail_length ДКА превышает ограничение FlatDFA, и слова разбираются симуляцией НКА
+std::function<void()> parse_batch_workload(int tail_length, int words_number, int word_length) {
+	string regex = "(a|b)*a";
+	for (int i = 0; i < tail_length; i++)
+		regex += "(a|b)";
+	auto fa = std::make_shared<FiniteAutomaton>(Regex(regex).to_thompson());
+	auto words = std::make_shared<vector<string>>();
+	std::mt19937 rng(0);
+	for (int i = 0; i < words_number; i++) {
+		string word;
+		for (int j = 0; j < word_length; j++)
+			word += static_cast<char>('a' + rng() % 2);
+		words->push_back(word);
+	}
+	return [fa, words]() { fa->parse_batch(*words); };
+}
+
+// потоковый разбор: один и тот же блок случайных букв подаётся chunks_number раз
+std::function<void()> stream_workload(int chunk_size, int chunks_number) {
+	auto fa = std::make_shared<FiniteAutomaton>(Regex("(a|b)*a(a|b)(a|b)(a|b)").to_thompson());
+	auto chunk = std::make_shared<string>();
+	std::mt19937 rng(0);
+	for (int i = 0; i < chunk_size; i++)
+		*chunk += static_cast<char>('a' + rng() % 2);
+	return [fa, chunk, chunks_number]() {
+		StreamMatcher matcher(*fa);
+		for (int i = 0; i < chunks_number; i++)
+			matcher.feed(chunk->data(), chunk->size());
+	};
+}
+
+// поиск вхождений в синтетическом логе: строки из случайных слов, в редких строках - слово
+// marker
+std::function<void()> search_workload(const string& regex, const string& marker,
+									  int lines_number) {
+	auto fa = std::make_shared<FiniteAutomaton>(Regex(regex).to_thompson());
+	auto text = std::make_shared<string>();
+	std::mt19937 rng(0);
+	for (int i = 0; i < lines_number; i++) {
+		*text += "2024-01-01 12:00:00 [info] worker";
+		for (int j = 0; j < 8; j++) {
+			*text += ' ';
+			for (int k = 0; k < 5; k++)
+				*text += static_cast<char>('a' + rng() % 26);
+		}
+		if (i % 100 == 0)
+			*text += " " + marker;
+		*text += '\n';
+	}
+	return [fa, text]() {
+		MatchSearcher searcher(*fa);
+		searcher.search(*text);
+	};
+}
+
+// поиск a*b|c в a...ac: с каждой позиции якорный ДКА доходит до c, не находя вхождения
+std::function<void()> search_adversarial_workload(int length) {
+	auto fa = std::make_shared<FiniteAutomaton>(Regex("a*b|c").to_thompson());
+	auto text = std::make_shared<string>(string(length, 'a') + "c");
+	return [fa, text]() {
+		MatchSearcher searcher(*fa);
+		searcher.search(*text);
+	};
+}
+
+int main(int argc, char** argv) {
+	Language::disable_retrieving_from_cache();
+
+	vector<Benchmark> benchmarks = {
+		{"determinize_small", []() { return determinize_workload(2000, 15, 4, 2, 2); }},
+		{"determinize_nested", []() { return determinize_workload(200, 60, 15, 4, 3); }},
+		{"determinize_alphabet", []() { return determinize_workload(200, 60, 10, 3, 8); }},
+		{"remove_eps", []() { return remove_eps_workload(200, 60, 15, 4, 3); }},
+		{"ambiguity", []() { return ambiguity_workload(50, 30, 8, 3, 3); }},
+		{"structural_ambiguity",
+		 []() { return structural_ambiguity_workload(50, 30, 8, 3, 3); }},
+		{"minimize_small", []() { return minimize_workload(2000, 15, 4, 2, 2); }},
+		{"minimize_large", []() { return minimize_workload(50, 200, 40, 4, 4); }},
+		{"transformation_monoid",
+		 []() { return transformation_monoid_workload(50, 30, 8, 3, 3); }},
+		{"glaister_shallit", []() { return glaister_shallit_workload(); }},
+		{"parse_regex", []() { return parse_regex_workload(20, 2000, 300, 5, 4); }},
+		{"antimirov", []() { return antimirov_workload(300, 15, 4, 2, 3); }},
+		{"arden", []() { return arden_workload(100, 15, 4, 2, 3); }},
+		{"merge_bisimilar", []() { return merge_bisimilar_workload(100, 200, 40, 4, 4); }},
+		{"subset", []() { return subset_workload(200, 25, 6, 3, 3); }},
+		{"equivalent", []() { return equivalent_workload(200, 40, 10, 3, 3); }},
+		{"product", []() { return product_workload(100, 25, 6, 3, 3); }},
+		{"parse_bitset", []() { return parse_bitset_workload(100000); }},
+		{"lazy_dfa_small", []() { return lazy_dfa_workload(6, 1000, 1000); }},
+		{"lazy_dfa_large", []() { return lazy_dfa_workload(20, 100, 10000); }},
+		{"brzozowski", []() { return brzozowski_workload(6, false, 1000, 1000); }},
+		{"brzozowski_negative", []() { return brzozowski_workload(6, true, 1000, 1000); }},
+		{"bitparallel_small", []() { return bitparallel_workload(100, 30, 10, 2, 100000); }},
+		{"bitparallel_large", []() { return bitparallel_workload(20, 300, 100, 2, 100000); }},
+		{"parse_batch", []() { return parse_batch_workload(3, 1000000, 30); }},
+		{"parse_batch_blowup", []() { return parse_batch_workload(20, 100000, 30); }},
+		{"stream", []() { return stream_workload(1 << 16, 1600); }},
+		{"search_prefix", []() { return search_workload("timeout(s|)", "timeouts", 1000000); }},
+		{"search_classes", []() { return search_workload("(q|z)(q|z)(q|z)*", "qqz", 1000000); }},
+		{"search_adversarial", []() { return search_adversarial_workload(1000000); }},
+	};
+
+	// без аргументов запускаются все замеры, иначе - перечисленные по имени
+	vector<string> selected(argv + 1, argv + argc);
+	for (const auto& benchmark : benchmarks) {
+		if (!selected.empty() &&
+			std::find(selected.begin(), selected.end(), benchmark.name) == selected.end())
+			continue;
+		std::function<void()> run = benchmark.prepare();
+		using clock = std::chrono::high_resolution_clock;
+		const auto start = clock::now();
+		run();
+		const auto end = clock::now();
+		const long long elapsed =
+			std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+		cout << benchmark.name << ": " << elapsed << " ms\n";
+	}
+}
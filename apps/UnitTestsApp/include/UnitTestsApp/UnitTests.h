@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "Objects/AlgExpression.h"
+#include "Objects/FiniteAutomaton.h"
 #include "gtest/gtest.h"
 
 class UnitTests {
@@ -17,8 +18,33 @@ class UnitTests {
 
 	using Lexeme = AlgExpression::Lexeme;
 	using LexemeType = AlgExpression::Lexeme::Type;
+	using ExpressionType = AlgExpression::Type;
 	static std::vector<Lexeme> parse_string(const std::string& str, bool allow_ref,
 											bool allow_negation) {
 		return AlgExpression::parse_string(str, allow_ref, allow_negation);
 	}
+
+	// добавляет переход в состояния автомата напрямую, как друзья FiniteAutomaton
+	static void add_transition(FiniteAutomaton& fa, int from, int to, // NOLINT(runtime/references)
+							   const Symbol& symbol) {
+		fa.states[from].add_transition(to, symbol);
+	}
+
+	// разбор строки в дерево выражения; false, если строка отвергнута
+	static bool from_string(AlgExpression& expr, // NOLINT(runtime/references)
+							const std::string& str, bool allow_ref, bool allow_negation) {
+		return expr.from_string(str, allow_ref, allow_negation);
+	}
+
+	// дерево выражения в префиксной записи: операция(левое,правое), у листьев - символ
+	static std::string tree_to_string(const AlgExpression& expr) {
+		std::string res = expr.type_to_str();
+		if (expr.term_l) {
+			res += "(" + tree_to_string(*expr.term_l);
+			if (expr.term_r)
+				res += "," + tree_to_string(*expr.term_r);
+			res += ")";
+		}
+		return res;
+	}
 };
@@ -1,13 +1,25 @@
 #include "UnitTestsApp/UnitTests.h"
 #include "AutomatonToImage/AutomatonToImage.h"
+#include "Fraction/BigInt.h"
+#include "Fraction/Fraction.h"
 #include "Interpreter/Interpreter.h"
+#include "Objects/AhoCorasick.h"
 #include "Objects/AlgExpression.h"
 #include "Objects/BackRefRegex.h"
+#include "Objects/BitParallelMatcher.h"
+#include "Objects/BitsetSimulator.h"
+#include "Objects/BrzozowskiDFA.h"
+#include "Objects/EpsilonClosures.h"
 #include "Objects/FiniteAutomaton.h"
+#include "Objects/FlatDFA.h"
 #include "Objects/Grammar.h"
 #include "Objects/Language.h"
+#include "Objects/LazyDFA.h"
+#include "Objects/MatchSearcher.h"
 #include "Objects/MemoryFiniteAutomaton.h"
 #include "Objects/Regex.h"
+#include "Objects/RegexDAG.h"
+#include "Objects/StreamMatcher.h"
 #include "Objects/TransformationMonoid.h"
 #include "Tester/Tester.h"
 
@@ -80,6 +92,128 @@ TEST(TestParseString, FromString) {
 	}
 }
 
+TEST(TestParseString, Precedence) {
+	struct Test {
+		string regex_str;
+		bool bref;
+		string tree;
+	};
+
+	vector<Test> tests = {
+		// приоритеты: альтернатива < конкатенация < итерация < отрицание
+		{"ab|c", false, "|(.(a,b),c)"},
+		{"a|bc", false, "|(a,.(b,c))"},
+		{"ab*", false, ".(a,*(b))"},
+		{"(ab)*", false, "*(.(a,b))"},
+		{"^a*", false, "*(^(a))"},
+		{"^(a*)", false, "^(*(a))"},
+		{"^ab", false, ".(^(a),b)"},
+		// альтернатива и конкатенация правоассоциативны
+		{"a|b|c", false, "|(a,|(b,c))"},
+		{"abc", false, ".(a,.(b,c))"},
+		{"(a|b)|c", false, "|(|(a,b),c)"},
+		{"(ab)c", false, ".(.(a,b),c)"},
+		// ячейки памяти и ссылки - атомы
+		{"[ab]:1&1*", true, ".([1](.(a,b)),*(&1))"},
+		{"[a|b]:1|&1c", true, "|([1](|(a,b)),.(&1,c))"},
+	};
+
+	for (const auto& t : tests) {
+		SCOPED_TRACE("Case: " + t.regex_str);
+		if (t.bref) {
+			BackRefRegex r;
+			ASSERT_TRUE(UnitTests::from_string(r, t.regex_str, true, false));
+			ASSERT_EQ(UnitTests::tree_to_string(r), t.tree);
+		} else {
+			Regex r;
+			ASSERT_TRUE(UnitTests::from_string(r, t.regex_str, false, true));
+			ASSERT_EQ(UnitTests::tree_to_string(r), t.tree);
+		}
+	}
+}
+
+TEST(TestParseString, Malformed) {
+	// итерация без операнда: до однопроходного парсера "(*" и "[*" принимались с неверным деревом
+	for (const string& regex_str : {"(*a)", "(*)", "a(*b)", "(*a|b)", "*a", "a|*b"}) {
+		SCOPED_TRACE("Case: " + regex_str);
+		Regex r;
+		ASSERT_FALSE(UnitTests::from_string(r, regex_str, false, true));
+	}
+	for (const string& regex_str : {"[*a]:1", "[*]:1&1", "([*a]:1)", "[a]:1[*&1]:2"}) {
+		SCOPED_TRACE("Case: " + regex_str);
+		BackRefRegex r;
+		ASSERT_FALSE(UnitTests::from_string(r, regex_str, true, false));
+	}
+}
+
+TEST(TestSymbol, Interning) {
+	Symbol a("a"), b('b');
+	Symbol a_annotated = a;
+	a_annotated.annote(1);
+	a_annotated.linearize(2);
+
+	ASSERT_EQ(a.get_id(), Symbol(string("a")).get_id());
+	ASSERT_NE(a.get_id(), a_annotated.get_id());
+	ASSERT_EQ(string(a_annotated), "a,1.2");
+	ASSERT_TRUE(a < b);
+	ASSERT_TRUE(a < a_annotated);
+
+	a_annotated.delinearize();
+	a_annotated.deannote();
+	ASSERT_EQ(a_annotated, a);
+	ASSERT_EQ(Symbol::Hasher()(a_annotated), Symbol::Hasher()(a));
+	ASSERT_TRUE(Symbol(Symbol::Epsilon).is_epsilon());
+	ASSERT_NE(Symbol::Ref(1), Symbol("&1"));
+	ASSERT_NE(Symbol::Ref(1), Symbol("1"));
+	ASSERT_EQ(string(Symbol::Ref(1)), "&1");
+}
+
+TEST(TestSymbol, MFA_References) {
+	// ссылки на переходах MFA строятся через Symbol::Ref, а не из строк
+	for (const string& reg_string : {"[a*]:1&1", "([&2b]:1&1[a*]:1[b*&1]:2)*", "[[a]:1]:2&1&2"}) {
+		BackRefRegex regex(reg_string);
+		for (const auto& mfa : {regex.to_mfa(), regex.to_mfa_additional()}) {
+			int references_number = 0;
+			for (const auto& state : mfa.get_states())
+				for (const auto& [symbol, _] : state.transitions) {
+					if (string(symbol)[0] != '&')
+						continue;
+					ASSERT_TRUE(symbol.is_ref());
+					ASSERT_EQ(symbol, Symbol::Ref(symbol.get_ref()));
+					references_number++;
+				}
+			ASSERT_GT(references_number, 0);
+		}
+	}
+}
+
+TEST(TestFraction, BigInt) {
+	// 10^400 умножается по Карацубе (больше 32 разрядов)
+	BigInt power = 1;
+	for (int i = 0; i < 400; i++)
+		power *= 10;
+	BigInt square = power * power;
+	ASSERT_EQ(square.to_string(), "1" + string(800, '0'));
+	ASSERT_EQ(square.digits_number(), 801u);
+	ASSERT_EQ(square / (power + 1), power - 1);
+	ASSERT_EQ(square % (power + 1), 1);
+	ASSERT_EQ(BigInt(-7) / 2, -3);
+	ASSERT_EQ(BigInt(-7) % 2, -1);
+	ASSERT_EQ(BigInt::gcd(power * 6, power * -60), power * 6);
+	ASSERT_TRUE(Fraction(power * 3, power * -6) == Fraction(-1, 2));
+
+	// малые дроби не сокращаются до вывода
+	Fraction third(1, 3);
+	Fraction sum = third + third + third;
+	ASSERT_TRUE(sum == Fraction(1, 1));
+	std::stringstream printed;
+	printed << sum;
+	ASSERT_EQ(printed.str(), "(1/1)");
+	ASSERT_TRUE(Fraction(-1, 2) > Fraction(-2, 3));
+	ASSERT_FALSE(Fraction(1, -2) > Fraction(-1, 2));
+	ASSERT_TRUE(Fraction(1, -2) >= Fraction(-1, 2));
+}
+
 TEST(TestNegativeRegex, Thompson) {
 	vector<FAState> states;
 	for (int i = 0; i < 9; i++) {
@@ -207,6 +341,37 @@ TEST(TestEqual, FA_Equal) {
 		Regex("a(bbb*aaa*)*bb*|aaa*(bbb*aaa*)*|b(aaa*bbb*)*aa*|bbb*(aaa*bbb*)*").to_glushkov()));
 }
 
+TEST(TestFreeze, FA_Freeze) {
+	FiniteAutomaton fa = Regex("(a|b)*ab|c").to_thompson();
+	FrozenAutomaton frozen = fa.freeze();
+	vector<FAState> states = fa.get_states();
+
+	ASSERT_EQ(frozen.size(), fa.size());
+	ASSERT_EQ(frozen.get_initial(), fa.get_initial());
+	ASSERT_EQ(frozen.get_alphabet_size(), 3);
+	ASSERT_EQ(frozen.get_symbol_id("b"), 1);
+	ASSERT_EQ(frozen.get_char_id('c'), frozen.get_symbol_id("c"));
+	ASSERT_NE(frozen.get_epsilon_id(), FrozenAutomaton::NoSymbol);
+	ASSERT_EQ(frozen.get_symbol_id("d"), FrozenAutomaton::NoSymbol);
+
+	int transitions_number = 0;
+	for (const auto& state : states) {
+		ASSERT_EQ(frozen.is_terminal(state.index), state.is_terminal);
+		int state_transitions_number = 0;
+		for (const auto& [symbol, states_to] : state.transitions) {
+			auto targets = frozen.get_transitions(state.index, frozen.get_symbol_id(symbol));
+			ASSERT_EQ(set<int>(targets.begin(), targets.end()), states_to);
+			state_transitions_number += states_to.size();
+		}
+		ASSERT_EQ(frozen.get_transitions(state.index).size(), state_transitions_number);
+		transitions_number += state_transitions_number;
+	}
+	ASSERT_EQ(frozen.transitions_number(), transitions_number);
+
+	for (const string& word : {"", "c", "ab", "abab", "abba", "bbaab", "abc"})
+		ASSERT_EQ(frozen.parse(word), fa.parse(word));
+}
+
 TEST(TestEquivalent, FA_Equivalent) {
 	vector<FAState> states1;
 	for (int i = 0; i < 3; i++) {
@@ -239,6 +404,17 @@ TEST(TestEquivalent, FA_Equivalent) {
 	ASSERT_TRUE(FiniteAutomaton::equivalent(fa1, fa2));
 }
 
+TEST(TestEquivalent, Counterexample) {
+	FiniteAutomaton fa1 = Regex("(a|b)*abb").to_thompson();
+	FiniteAutomaton fa2 = Regex("(a|b)*ab(a|b)").to_glushkov();
+
+	ASSERT_EQ(FiniteAutomaton::find_equivalence_counterexample(
+				  fa1, Regex("(b*a)*(a|b)*abb").to_antimirov()),
+			  std::nullopt);
+	ASSERT_EQ(FiniteAutomaton::find_equivalence_counterexample(fa1, fa2), "aba");
+	ASSERT_EQ(FiniteAutomaton::find_equivalence_counterexample(fa1, Regex("b*").to_ilieyu()), "");
+}
+
 TEST(TestBisimilar, FA_Bisimilar) {
 	vector<FAState> states1;
 	for (int i = 0; i < 3; i++) {
@@ -317,6 +493,17 @@ TEST(TestSubset, Regex_Subset) {
 	ASSERT_TRUE(!Regex("ab*").subset(Regex("a*b*")));
 }
 
+TEST(TestSubset, Counterexample) {
+	FiniteAutomaton fa1 = Regex("(a|b)*a").to_thompson();
+	FiniteAutomaton fa2 = Regex("a*|b*a").to_glushkov();
+
+	ASSERT_EQ(fa1.find_subset_counterexample(Regex("a(a|b)*a").to_ilieyu()), std::nullopt);
+	ASSERT_EQ(fa1.find_subset_counterexample(fa2), "");
+	ASSERT_EQ(fa2.find_subset_counterexample(fa1), "aba");
+	ASSERT_TRUE(Regex("(a|b)*").to_thompson().is_universal());
+	ASSERT_TRUE(!Regex("(a|b)*a|b*").to_glushkov().is_universal());
+}
+
 TEST(TestEqual, Regex_Equal) {
 	Regex r1("a(bbb*aaa*)*bb*|aaa*(bbb*aaa*)*");
 	Regex r2("aaa*(bbb*aaa*)*|a(bbb*aaa*)*bb*");
@@ -328,6 +515,75 @@ TEST(TestEqual, Regex_Equal) {
 	ASSERT_TRUE(!Regex::equal(r1, r3));
 }
 
+TEST(TestEqual, RegexDAG_HashConsing) {
+	RegexDAG dag;
+	auto node = [&dag](const string& rgx_str) { return dag.from_regex(Regex(rgx_str)); };
+	// равенство с точностью до ACI и тождеств - равенство указателей
+	ASSERT_EQ(node("a|b"), node("b|a"));
+	ASSERT_EQ(node("(a|b)|c*"), node("c*|(b|a)|a"));
+	ASSERT_EQ(node("(ab)c"), node("a(bc)"));
+	ASSERT_EQ(node("(a*)*"), node("a*"));
+	ASSERT_EQ(node("^^(ab)"), node("ab"));
+	ASSERT_EQ(node("(a|b*)c"), node("(b*|a)c"));
+	ASSERT_NE(node("ab"), node("ba"));
+	ASSERT_NE(node("a*"), node("a"));
+
+	auto a = dag.symb("a");
+	ASSERT_EQ(dag.alt(a, dag.empty()), a);
+	ASSERT_EQ(dag.alt(dag.eps(), dag.star(a)), dag.star(a));
+	ASSERT_EQ(dag.conc(dag.eps(), a), a);
+	ASSERT_EQ(dag.conc(a, dag.empty()), dag.empty());
+	ASSERT_EQ(dag.star(dag.empty()), dag.eps());
+	ASSERT_TRUE(dag.star(a)->nullable);
+	ASSERT_FALSE(dag.negative(dag.star(a))->nullable);
+
+	// общие подвыражения хранятся один раз: новые ноды - (a|b)*, c(a|b)* и корень
+	int size = dag.size();
+	node("(a|b)*c(b|a)*");
+	ASSERT_EQ(dag.size(), size + 3);
+
+	for (const string& rgx_str : {"(a|b)*c(b|a)*", "a(bbb*aaa*)*bb*|aaa*(bbb*aaa*)*", "^(ab)"}) {
+		Regex r(rgx_str);
+		ASSERT_TRUE(Regex::equivalent(r, dag.to_regex(node(rgx_str))));
+	}
+}
+
+TEST(TestMove, Regex_Move) {
+	// перемещение передаёт дерево, исходное выражение становится пустым (eps)
+	Regex r1("(ab|c)*d");
+	string tree = UnitTests::tree_to_string(r1);
+	Regex r2(std::move(r1));
+	ASSERT_EQ(UnitTests::tree_to_string(r2), tree);
+	ASSERT_EQ(UnitTests::tree_to_string(r1), "ε");
+	r1 = Regex("e|f");
+	ASSERT_EQ(UnitTests::tree_to_string(r1), "|(e,f)");
+	r1 = std::move(r2);
+	ASSERT_EQ(UnitTests::tree_to_string(r1), tree);
+	ASSERT_EQ(UnitTests::tree_to_string(r2), "ε");
+	ASSERT_TRUE(Regex::equivalent(r1, Regex("(ab|c)*d")));
+
+	// поддеревья без копирования: то же дерево, что у конструктора с копированием
+	Regex l("a*"), r("b|c");
+	Regex copied(UnitTests::ExpressionType::conc, &l, &r);
+	Regex conc(UnitTests::ExpressionType::conc, std::move(l), std::move(r));
+	ASSERT_EQ(UnitTests::tree_to_string(conc), UnitTests::tree_to_string(copied));
+	ASSERT_EQ(UnitTests::tree_to_string(conc), ".(*(a),|(b,c))");
+	ASSERT_EQ(UnitTests::tree_to_string(l), "ε");
+	ASSERT_EQ(UnitTests::tree_to_string(r), "ε");
+	Regex star(UnitTests::ExpressionType::star, std::move(conc));
+	ASSERT_EQ(UnitTests::tree_to_string(star), "*(.(*(a),|(b,c)))");
+	ASSERT_EQ(UnitTests::tree_to_string(conc), "ε");
+
+	BackRefRegex b1("[a*]:1&1");
+	tree = UnitTests::tree_to_string(b1);
+	BackRefRegex b2(std::move(b1));
+	ASSERT_EQ(UnitTests::tree_to_string(b2), tree);
+	ASSERT_EQ(UnitTests::tree_to_string(b1), "ε");
+	b1 = std::move(b2);
+	ASSERT_EQ(UnitTests::tree_to_string(b1), tree);
+	ASSERT_TRUE(b1.to_mfa().parse("aaaa").second);
+}
+
 TEST(TestRemoveTrap, FASizeEquality) {
 	Regex r1("ca*a(b|c)*");
 	Regex r2("caa*b*");
@@ -510,6 +766,49 @@ TEST(TestTransformationMonoid, IsMinimal) {
 	ASSERT_TRUE(tm5.is_minimal());
 }
 
+TEST(TestTransformationMonoid, NFA) {
+	// НКА языка (a|b)*a(a|b)^k: образ слова определяется его длиной (до k + 1) и позициями
+	// букв a среди последних k + 1 букв, поэтому классов 2^(k + 2) - 2, а множеств в образах
+	// 2^(k + 1) + k + 2. При k = 15 номера множеств не помещаются в 16 бит
+	auto make_fa = [](int k) {
+		vector<FAState> states;
+		for (int i = 0; i < k + 2; i++)
+			states.emplace_back(i, std::to_string(i), i == k + 1);
+		states[0].add_transition(0, "a");
+		states[0].add_transition(0, "b");
+		states[0].add_transition(1, "a");
+		for (int i = 1; i <= k; i++) {
+			states[i].add_transition(i + 1, "a");
+			states[i].add_transition(i + 1, "b");
+		}
+		return FiniteAutomaton(0, states, {"a", "b"});
+	};
+	for (int k : {3, 15}) {
+		SCOPED_TRACE("k = " + std::to_string(k));
+		TransformationMonoid tm(make_fa(k));
+		ASSERT_EQ(tm.class_card(), (1 << (k + 2)) - 2);
+		ASSERT_EQ(tm.class_length(), k + 1);
+	}
+}
+
+TEST(TestTransformationMonoid, AhoCorasick) {
+	AhoCorasick index(3);
+	ASSERT_FALSE(index.contains_match({0, 1, 2}));
+	index.add({0, 1, 2});
+	ASSERT_TRUE(index.contains_match({2, 0, 1, 2, 0}));
+	ASSERT_FALSE(index.contains_match({0, 1, 0, 1, 1, 2}));
+	// образцы добавляются между запросами; суффикс одного - префикс другого
+	index.add({1, 2, 1});
+	index.add({2, 2});
+	ASSERT_TRUE(index.contains_match({0, 1, 2, 1}));
+	ASSERT_TRUE(index.contains_match({1, 2, 2}));
+	ASSERT_FALSE(index.contains_match({0, 1, 0, 2, 1, 2, 0}));
+	ASSERT_EQ(index.size(), 3);
+	ASSERT_THROW(index.add({3}), std::invalid_argument);
+	index.add({});
+	ASSERT_TRUE(index.contains_match({}));
+}
+
 TEST(TestGlaisterShallit, GetClassesNumber) {
 	auto check_classes_number = [](const string& rgx_str, int num) {
 		ASSERT_TRUE(Regex(rgx_str).to_glushkov().get_classes_number_GlaisterShallit() == num);
@@ -523,6 +822,15 @@ TEST(TestGlaisterShallit, GetClassesNumber) {
 	check_classes_number("a(b|c)(a|b)(b|c)", 5);
 	check_classes_number("abc|bca", 6);
 	check_classes_number("abc|bbc", 4);
+
+	// при исчерпании бюджета - оценка снизу; ветви первого уровня делятся между потоками
+	FiniteAutomaton fa = Regex("(ab|ba)*(abb|bba)*a").to_glushkov();
+	FoolingSetSearch::Options budget;
+	budget.max_nodes = 1;
+	ASSERT_LE(fa.get_classes_number_GlaisterShallit(nullptr, budget), 8);
+	FoolingSetSearch::Options threads;
+	threads.threads_number = 2;
+	ASSERT_EQ(fa.get_classes_number_GlaisterShallit(nullptr, threads), 8);
 }
 
 TEST(TestToMFA, ToMfa) {
@@ -651,6 +959,43 @@ TEST(TestIsDeterministic, MFA_IsDeterministic) {
 	ASSERT_TRUE(BackRefRegex("[a]:1").to_mfa().is_deterministic());
 }
 
+TEST(TestRemoveEps, FA_EpsilonClosures) {
+	// 0 и 1 образуют eps-цикл, из которого eps-переход ведёт в 2
+	vector<FAState> states;
+	for (int i = 0; i < 4; i++)
+		states.emplace_back(i, set<int>{i}, std::to_string(i), i == 3, FAState::Transitions());
+	states[0].add_transition(1, Symbol::Epsilon);
+	states[1].add_transition(0, Symbol::Epsilon);
+	states[1].add_transition(2, Symbol::Epsilon);
+	states[2].add_transition(3, "a");
+	FiniteAutomaton fa(0, states, {"a"});
+
+	auto closures = fa.get_epsilon_closures();
+	ASSERT_EQ(closures->get(0), vector<int>({0, 1, 2}));
+	ASSERT_EQ(closures->get(1), vector<int>({0, 1, 2}));
+	ASSERT_EQ(closures->get(3), vector<int>({3}));
+	ASSERT_EQ(closures->get_component(0), closures->get_component(1));
+	ASSERT_EQ(closures->components_number(), 3);
+	// индекс строится один раз; копии и присвоенные автоматы строят свой
+	ASSERT_EQ(fa.get_epsilon_closures(), closures);
+	FiniteAutomaton copy(fa);
+	ASSERT_EQ(copy.get_epsilon_closures()->get(0), closures->get(0));
+	states[3].add_transition(0, Symbol::Epsilon);
+	copy = FiniteAutomaton(0, states, {"a"});
+	ASSERT_EQ(copy.get_epsilon_closures()->get(3), vector<int>({0, 1, 2, 3}));
+	ASSERT_TRUE(fa.remove_eps().parse("a").second);
+	// изменение состояний в обход методов автомата (как у друзей) сбрасывает индекс
+	closures = fa.get_epsilon_closures();
+	UnitTests::add_transition(fa, 2, 0, Symbol::Epsilon);
+	ASSERT_NE(fa.get_epsilon_closures(), closures);
+	ASSERT_EQ(closures->get(2), vector<int>({2}));
+	ASSERT_EQ(fa.get_epsilon_closures()->get(2), vector<int>({0, 1, 2}));
+	ASSERT_EQ(fa.get_epsilon_closures()->components_number(), 2);
+	UnitTests::add_transition(fa, 3, 2, Symbol::Epsilon);
+	ASSERT_EQ(fa.get_epsilon_closures()->get(3), vector<int>({0, 1, 2, 3}));
+	ASSERT_TRUE(fa.remove_eps().parse("aa").second);
+}
+
 TEST(TestRemoveEps, MFA_RemoveEps) {
 	MemoryFiniteAutomaton mfa = BackRefRegex("[[a]:1]:2&1").to_mfa();
 	mfa = mfa.remove_eps();
@@ -668,6 +1013,119 @@ TEST(TestIsAcreg, BRegex_IsAcreg) {
 	ASSERT_FALSE(BackRefRegex("([&2]:1([&1]:2|[a]:2))*").is_acreg());
 }
 
+TEST(TestParsing, FA_ParseBitset) {
+	BitsetSimulator simulator(Regex("(a|a)*b").to_thompson());
+	string word(100, 'a');
+
+	ASSERT_FALSE(simulator.parse(word).second);
+	ASSERT_TRUE(simulator.parse(word + "b").second);
+	ASSERT_FALSE(simulator.parse(word + "ba").second);
+}
+
+TEST(TestParsing, FA_LazyDFA) {
+	FiniteAutomaton fa = Regex("(a|b)*a(a|b)(a|b)").to_thompson();
+	// кэш из двух макросостояний очищается почти на каждом шаге
+	LazyDFA cached(fa), flushed(fa, 2);
+
+	for (const string& word : {"", "a", "abb", "bbaba", "babbb", "aaaaab", "abaabbb"}) {
+		ASSERT_EQ(cached.parse(word), fa.parse(word).second);
+		ASSERT_EQ(flushed.parse(word), fa.parse(word).second);
+	}
+	ASSERT_EQ(cached.get_flushes_number(), 0);
+	ASSERT_GT(flushed.get_flushes_number(), 0);
+}
+
+TEST(TestParsing, Regex_BitParallel) {
+	for (const string& regex : {"(a|b)*a(a|b)", "(ab|b)*|a*ba", "((a|)b*)*c"}) {
+		FiniteAutomaton fa = Regex(regex).to_glushkov();
+		BitParallelMatcher matcher = Regex(regex).compile_bitparallel();
+		ASSERT_EQ(matcher.size(), fa.size());
+		for (const string& word : {"", "a", "ab", "aba", "bab", "abba", "bbbbba", "abbac", "c"})
+			ASSERT_EQ(matcher.parse(word), fa.parse(word).second);
+	}
+}
+
+TEST(TestParsing, Regex_BrzozowskiDFA) {
+	for (const string& regex : {"(a|b)*a(a|b)", "(ab|b)*|a*ba", "(^a|b)c", "^((a|b)*ab)c*"}) {
+		FiniteAutomaton fa = Regex(regex).to_thompson();
+		BrzozowskiDFA dfa((Regex(regex)));
+		for (const string& word : {"", "a", "ab", "aba", "bab", "abba", "bbbbba", "abc", "cc", "d"})
+			ASSERT_EQ(dfa.parse(word), fa.parse(word).second);
+		// производных с точностью до ACI конечное число: длинное слово не добавляет состояний
+		string word(30, 'a');
+		for (int i = 0; i < word.size(); i += 3)
+			word[i] = 'b';
+		ASSERT_EQ(dfa.parse(word), fa.parse(word).second);
+		ASSERT_LT(dfa.states_number(), 20);
+	}
+}
+
+TEST(TestParsing, FA_ParseBatch) {
+	FiniteAutomaton fa = Regex("(a|b)*a(a|b)|c*").to_thompson();
+	vector<string> words = {"", "a", "ab", "aab", "ba", "bbbab", "abab", "ccc", "cab", "d"};
+	// пакет длиннее восьми слов проходит все ветви чередования
+	for (int i = 0; i < 3; i++) {
+		vector<string> copy(words);
+		words.insert(words.end(), copy.begin(), copy.end());
+	}
+
+	vector<bool> results = fa.parse_batch(words, 2);
+	ASSERT_EQ(results.size(), words.size());
+	for (int i = 0; i < words.size(); i++)
+		ASSERT_EQ(results[i], fa.parse(words[i]).second);
+
+	// ДКА больше ограничения: разбор идёт симуляцией НКА
+	FlatDFA simulated(fa, 2);
+	ASSERT_FALSE(simulated.is_determinized());
+	ASSERT_EQ(simulated.parse_batch(words, 2), results);
+	ASSERT_TRUE(FlatDFA(fa).is_determinized());
+}
+
+TEST(TestParsing, FA_StreamMatcher) {
+	FiniteAutomaton fa = Regex("(ab)*(a|)").to_thompson();
+	StreamMatcher matcher(fa);
+	string input = "ababab";
+
+	ASSERT_TRUE(matcher.is_accepting());
+	for (int i = 0; i < input.size(); i += 4)
+		matcher.feed(input.data() + i, std::min<size_t>(4, input.size() - i));
+	ASSERT_TRUE(matcher.is_accepting());
+	matcher.feed("bab", 3);
+	ASSERT_FALSE(matcher.is_accepting());
+	ASSERT_EQ(matcher.get_position(), 9);
+	ASSERT_EQ(matcher.get_longest_accepted_prefix(), 6);
+
+	matcher.reset();
+	matcher.feed("b", 1);
+	ASSERT_FALSE(matcher.is_accepting());
+	ASSERT_EQ(matcher.get_longest_accepted_prefix(), 0);
+}
+
+TEST(TestParsing, FA_MatchSearcher) {
+	using Match = MatchSearcher::Match;
+	MatchSearcher searcher(Regex("ab(c|d)*").to_thompson());
+	ASSERT_EQ(searcher.get_prefix(), "ab");
+	ASSERT_EQ(searcher.search("xxabcdab ab\nabdx"),
+			  vector<Match>({{2, 4}, {6, 2}, {9, 2}, {12, 3}}));
+	ASSERT_TRUE(searcher.search("bbaac").empty());
+
+	// самое левое вхождение, среди них - самое длинное; пустые вхождения не выводятся
+	MatchSearcher classes(Regex("(a|b)*c|b").to_glushkov());
+	ASSERT_EQ(classes.get_prefix(), "");
+	ASSERT_EQ(classes.search("xbxaabcb"), vector<Match>({{1, 1}, {3, 4}, {7, 1}}));
+	MatchSearcher empty(Regex("a*").to_thompson());
+	ASSERT_EQ(empty.search("baab"), vector<Match>({{1, 2}}));
+
+	// ни одно из начал a...a не даёт вхождения: начала отмечаются обратным проходом
+	MatchSearcher adversarial(Regex("a*b|c").to_thompson());
+	string text = string(10000, 'a') + "c" + string(10000, 'a') + "bac";
+	ASSERT_EQ(adversarial.search(text),
+			  vector<Match>({{10000, 1}, {10001, 10001}, {20003, 1}}));
+	MatchSearcher nonempty(Regex("(a*b|c|)d*").to_glushkov());
+	ASSERT_EQ(nonempty.search(string(1000, 'a') + "cdd" + string(1000, 'a')),
+			  vector<Match>({{1000, 3}}));
+}
+
 TEST(TestParsing, MFA_parse) {
 	using Test = std::tuple<bool, string, string, bool>;
 	vector<Test> tests = {
@@ -951,4 +1409,23 @@ TEST(TestAmbiguity, AmbiguityValues) {
 			break;
 		}
 	});
+}
+
+TEST(TestAmbiguity, StructuralAmbiguity) {
+	using Test = std::tuple<string, FiniteAutomaton::AmbiguityValue>;
+	vector<Test> tests = {
+		{"abc", FiniteAutomaton::unambigious},
+		{"(a|a)b*", FiniteAutomaton::finitely_ambiguous},
+		{"(a|)(ab|aaa|baa)*(a|)", FiniteAutomaton::finitely_ambiguous},
+		{"a*a*", FiniteAutomaton::polynomially_ambigious},
+		{"(ab)*ab(ab)*", FiniteAutomaton::polynomially_ambigious},
+		{"(aab|aab)*", FiniteAutomaton::exponentially_ambiguous},
+		{"((c|c)ba)*", FiniteAutomaton::exponentially_ambiguous},
+		// неоднозначных слов мало, поэтому ambiguity - almost_unambigious
+		{"(a|b|c)*(d|d)*(a|b|c|d)*", FiniteAutomaton::exponentially_ambiguous},
+	};
+	for (const auto& [reg_string, expected_res] : tests) {
+		ASSERT_EQ(Regex(reg_string).to_glushkov().structural_ambiguity(), expected_res);
+		ASSERT_EQ(Regex(reg_string).to_thompson().structural_ambiguity(), expected_res);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Целое произвольной длины: знак и модуль из 64-битных разрядов (младшими вперёд). Числа
+// до InlineLimbs разрядов хранятся в самом объекте, без выделения памяти. Арифметика
+// выполняется на месте (+=, -=, *=); длинные числа умножаются по Карацубе, делятся
+// алгоритмом D Кнута, НОД вычисляется бинарным алгоритмом (Стейна)
+class BigInt {
+  public:
+	using Limb = uint64_t;
+
+  private:
+	inline static const int InlineLimbs = 2;
+
+	bool negative = false;
+	// число значащих разрядов модуля (у нуля - 0)
+	int length = 0;
+	Limb inline_limbs[InlineLimbs] = {};
+	// разряды длинных чисел; пока вектор пуст, используется inline_limbs
+	std::vector<Limb> heap_limbs;
+
+	Limb* limbs();
+	const Limb* limbs() const;
+	// место под capacity разрядов; значащие разряды сохраняются
+	void reserve(int capacity);
+	// отбрасывает старшие нулевые разряды
+	void trim();
+	void assign(const Limb* data, int size, bool is_negative);
+
+	int compare_magnitude(const BigInt&) const;
+	// |this| + |other|, |this| - |other| (при |this| >= |other|), |other| - |this|
+	void add_magnitude(const BigInt&);
+	void subtract_magnitude(const BigInt&);
+	void subtract_from_magnitude(const BigInt&);
+	void add(const BigInt&, bool other_negative);
+	static void divide(const BigInt& dividend, const BigInt& divisor, BigInt* quotient,
+					   BigInt* remainder);
+
+  public:
+	BigInt();
+	BigInt(long long); // NOLINT(runtime/explicit)
+	BigInt(const BigInt&);
+	BigInt(BigInt&&) noexcept;
+	BigInt& operator=(const BigInt&);
+	BigInt& operator=(BigInt&&) noexcept;
+
+	BigInt& operator+=(const BigInt&);
+	BigInt& operator-=(const BigInt&);
+	BigInt& operator*=(const BigInt&);
+	// частное округляется к нулю, остаток имеет знак делимого (как у встроенных типов)
+	BigInt& operator/=(const BigInt&);
+	BigInt& operator%=(const BigInt&);
+
+	BigInt operator-() const;
+	BigInt operator+(const BigInt&) const;
+	BigInt operator-(const BigInt&) const;
+	BigInt operator*(const BigInt&) const;
+	BigInt operator/(const BigInt&) const;
+	BigInt operator%(const BigInt&) const;
+
+	bool operator==(const BigInt&) const;
+	bool operator!=(const BigInt&) const;
+	bool operator<(const BigInt&) const;
+	bool operator<=(const BigInt&) const;
+	bool operator>(const BigInt&) const;
+	bool operator>=(const BigInt&) const;
+
+	// -1, 0 или 1
+	int sign() const;
+	bool is_zero() const;
+	// число значащих разрядов модуля
+	int limbs_number() const;
+	// число десятичных цифр модуля (у нуля - 1)
+	size_t digits_number() const;
+	std::string to_string() const;
+
+	// неотрицательный наибольший общий делитель; gcd(0, 0) = 0
+	static BigInt gcd(const BigInt&, const BigInt&);
+
+	friend std::ostream& operator<<(std::ostream&, const BigInt&);
+};
@@ -1,33 +1,42 @@
 #pragma once
 #include <iostream>
 
-#include "InfInt.h"
+#include "BigInt.h"
 
+// Рациональное число с отложенным сокращением: после операций дробь сокращается, только
+// если числитель и знаменатель вместе заняли больше ReductionLimbs разрядов, а перед
+// выводом - всегда. Знаменатель всегда положителен, поэтому сравнения выполняются
+// перекрёстным умножением после проверки знаков, без вычитания и сокращения
 class Fraction {
-	InfInt numerator;
-	InfInt denominator;
+	BigInt numerator;
+	BigInt denominator;
 
   public:
 	inline static unsigned long long last_number_of_digits = 0;
+	// порог (в 64-битных разрядах) суммарной длины числителя и знаменателя для сокращения
+	inline static const int ReductionLimbs = 4;
 	Fraction();
-	Fraction(InfInt n, InfInt d);
+	Fraction(BigInt n, BigInt d);
 	~Fraction();
-	Fraction operator+(const Fraction& f);
-	Fraction operator-(const Fraction& f);
-	Fraction operator*(const Fraction& f);
-	Fraction operator/(const Fraction& f);
+	Fraction operator+(const Fraction& f) const;
+	Fraction operator-(const Fraction& f) const;
+	Fraction operator*(const Fraction& f) const;
+	Fraction operator/(const Fraction& f) const;
 	Fraction operator+=(const Fraction& f);
 	Fraction operator++();
 	Fraction operator++(int);
-	bool operator>(const Fraction& f);
-	bool operator==(const Fraction& f);
-	bool operator>=(const Fraction& f);
+	bool operator>(const Fraction& f) const;
+	bool operator==(const Fraction& f) const;
+	bool operator>=(const Fraction& f) const;
 	friend std::ostream& operator<<(std::ostream& output, const Fraction& f);
 
   private:
+	// сравнение n1/d1 и n2/d2 по знаку n1 * d2 - n2 * d1: -1, 0 или 1
+	int compare(const Fraction& f) const;
 	void simplify() {
-		reduction();
 		fix_sign();
+		if (numerator.limbs_number() + denominator.limbs_number() > ReductionLimbs)
+			reduction();
 	}
 	void fix_sign() {
 		if (denominator < 0) {
@@ -36,11 +45,10 @@ class Fraction {
 		}
 	}
 	void reduction() {
-		InfInt common = gcd(numerator, denominator);
-		numerator /= common;
-		denominator /= common;
-	}
-	InfInt gcd(InfInt x, InfInt y) {
-		return y == 0 ? x : gcd(y, x % y);
+		BigInt common = BigInt::gcd(numerator, denominator);
+		if (common != 1) {
+			numerator /= common;
+			denominator /= common;
+		}
 	}
-};
\ No newline at end of file
+};
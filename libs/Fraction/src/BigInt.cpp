@@ -0,0 +1,583 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "Fraction/BigInt.h"
+
+#ifndef __SIZEOF_INT128__
+#error "BigInt requires a 128-bit integer type (GCC or Clang)"
+#endif
+
+using std::string;
+using std::vector;
+using Limb = BigInt::Limb;
+
+namespace {
+using DoubleLimb = unsigned __int128;
+
+const int LimbBits = 64;
+// ниже этой длины множителей (в разрядах) умножение столбиком быстрее Карацубы
+const int KaratsubaThreshold = 32;
+// наибольшая степень десяти, помещающаяся в разряд
+const Limb DecimalChunk = 10000000000000000000ULL;
+const int DecimalChunkDigits = 19;
+
+int trimmed_length(const Limb* data, int size) {
+	while (size > 0 && data[size - 1] == 0)
+		size--;
+	return size;
+}
+
+int compare_magnitudes(const Limb* a, int a_size, const Limb* b, int b_size) {
+	if (a_size != b_size)
+		return a_size < b_size ? -1 : 1;
+	for (int i = a_size - 1; i >= 0; i--)
+		if (a[i] != b[i])
+			return a[i] < b[i] ? -1 : 1;
+	return 0;
+}
+
+// target[0, size) += addend[0, addend_size) (addend_size <= size); возвращает перенос
+Limb add_to(Limb* target, int size, const Limb* addend, int addend_size) {
+	Limb carry = 0;
+	int i = 0;
+	for (; i < addend_size; i++) {
+		DoubleLimb sum = DoubleLimb(target[i]) + addend[i] + carry;
+		target[i] = static_cast<Limb>(sum);
+		carry = static_cast<Limb>(sum >> LimbBits);
+	}
+	for (; carry && i < size; i++)
+		carry = ++target[i] == 0;
+	return carry;
+}
+
+// target[0, size) -= subtrahend[0, subtrahend_size) (subtrahend_size <= size); возвращает заём
+Limb subtract_from(Limb* target, int size, const Limb* subtrahend, int subtrahend_size) {
+	Limb borrow = 0;
+	int i = 0;
+	for (; i < subtrahend_size; i++) {
+		Limb difference = target[i] - subtrahend[i];
+		Limb next_borrow = target[i] < subtrahend[i];
+		next_borrow += difference < borrow;
+		target[i] = difference - borrow;
+		borrow = next_borrow;
+	}
+	for (; borrow && i < size; i++)
+		borrow = target[i]-- == 0;
+	return borrow;
+}
+
+// result[0, a_size + b_size) = a * b столбиком; result не пересекается с a и b
+void multiply_schoolbook(Limb* result, const Limb* a, int a_size, const Limb* b, int b_size) {
+	std::fill(result, result + a_size + b_size, 0);
+	for (int i = 0; i < a_size; i++) {
+		Limb carry = 0;
+		for (int j = 0; j < b_size; j++) {
+			DoubleLimb product = DoubleLimb(a[i]) * b[j] + result[i + j] + carry;
+			result[i + j] = static_cast<Limb>(product);
+			carry = static_cast<Limb>(product >> LimbBits);
+		}
+		result[i + b_size] = carry;
+	}
+}
+
+// result[0, a_size + b_size) = a * b; result не пересекается с a и b
+void multiply(Limb* result, const Limb* a, int a_size, const Limb* b, int b_size) {
+	if (a_size < b_size) {
+		std::swap(a, b);
+		std::swap(a_size, b_size);
+	}
+	if (b_size < KaratsubaThreshold) {
+		multiply_schoolbook(result, a, a_size, b, b_size);
+		return;
+	}
+	int half = (a_size + 1) / 2;
+	if (b_size <= half) {
+		// несбалансированные множители: a = a1 * B^half + a0, a * b = a0 * b + (a1 * b) B^half
+		multiply(result, a, half, b, b_size);
+		std::fill(result + half + b_size, result + a_size + b_size, 0);
+		vector<Limb> high(a_size - half + b_size);
+		multiply(high.data(), a + half, a_size - half, b, b_size);
+		add_to(result + half, a_size + b_size - half, high.data(), static_cast<int>(high.size()));
+		return;
+	}
+	// a = a1 * B^half + a0, b = b1 * B^half + b0:
+	// a * b = z2 * B^(2 half) + ((a0 + a1)(b0 + b1) - z0 - z2) * B^half + z0
+	int a_high = a_size - half, b_high = b_size - half;
+	multiply(result, a, half, b, half);
+	multiply(result + 2 * half, a + half, a_high, b + half, b_high);
+	vector<Limb> a_sum(a, a + half), b_sum(b, b + half);
+	a_sum.push_back(add_to(a_sum.data(), half, a + half, a_high));
+	b_sum.push_back(add_to(b_sum.data(), half, b + half, b_high));
+	vector<Limb> middle(2 * half + 2);
+	multiply(middle.data(), a_sum.data(), half + 1, b_sum.data(), half + 1);
+	int middle_size = static_cast<int>(middle.size());
+	subtract_from(middle.data(), middle_size, result, 2 * half);
+	subtract_from(middle.data(), middle_size, result + 2 * half, a_high + b_high);
+	// старшие разряды middle нулевые: произведение помещается в a_size + b_size разрядов
+	add_to(result + half,
+		   a_size + b_size - half,
+		   middle.data(),
+		   std::min(trimmed_length(middle.data(), middle_size), a_size + b_size - half));
+}
+
+// data[0, size) /= divisor; возвращает остаток
+Limb divide_by_limb(Limb* data, int size, Limb divisor) {
+	DoubleLimb remainder = 0;
+	for (int i = size - 1; i >= 0; i--) {
+		DoubleLimb current = (remainder << LimbBits) | data[i];
+		data[i] = static_cast<Limb>(current / divisor);
+		remainder = current % divisor;
+	}
+	return static_cast<Limb>(remainder);
+}
+
+// result[0, size + 1) = data << shift (0 <= shift < LimbBits)
+void shift_left(Limb* result, const Limb* data, int size, int shift) {
+	Limb carry = 0;
+	for (int i = 0; i < size; i++) {
+		result[i] = (data[i] << shift) | carry;
+		carry = shift ? data[i] >> (LimbBits - shift) : 0;
+	}
+	result[size] = carry;
+}
+
+// data >>= shift на месте (0 <= shift < LimbBits)
+void shift_right(Limb* data, int size, int shift) {
+	if (shift == 0)
+		return;
+	for (int i = 0; i < size; i++)
+		data[i] = (data[i] >> shift) | (i + 1 < size ? data[i + 1] << (LimbBits - shift) : 0);
+}
+
+// алгоритм D Кнута: quotient[0, u_size - v_size + 1) и remainder[0, v_size) для u / v,
+// v_size >= 2, u_size >= v_size, старший разряд v ненулевой
+void divide_magnitudes(const Limb* u, int u_size, const Limb* v, int v_size, Limb* quotient,
+					   Limb* remainder) {
+	// нормализация: старший бит делителя единичный, тогда оценка цифры частного
+	// по двум старшим разрядам ошибается не более чем на 2
+	int shift = __builtin_clzll(v[v_size - 1]);
+	vector<Limb> divisor(v_size + 1), rest(u_size + 1);
+	shift_left(divisor.data(), v, v_size, shift);
+	shift_left(rest.data(), u, u_size, shift);
+	Limb top = divisor[v_size - 1], next = divisor[v_size - 2];
+	for (int j = u_size - v_size; j >= 0; j--) {
+		DoubleLimb numerator = (DoubleLimb(rest[j + v_size]) << LimbBits) | rest[j + v_size - 1];
+		DoubleLimb digit = numerator / top;
+		DoubleLimb digit_remainder = numerator % top;
+		while ((digit >> LimbBits) ||
+			   digit * next > ((digit_remainder << LimbBits) | rest[j + v_size - 2])) {
+			digit--;
+			digit_remainder += top;
+			if (digit_remainder >> LimbBits)
+				break;
+		}
+		// rest[j, j + v_size] -= digit * divisor
+		Limb carry = 0, borrow = 0;
+		for (int i = 0; i <= v_size; i++) {
+			DoubleLimb product = digit * (i < v_size ? divisor[i] : 0) + carry;
+			carry = static_cast<Limb>(product >> LimbBits);
+			Limb low = static_cast<Limb>(product);
+			Limb difference = rest[i + j] - low;
+			Limb next_borrow = rest[i + j] < low;
+			next_borrow += difference < borrow;
+			rest[i + j] = difference - borrow;
+			borrow = next_borrow;
+		}
+		if (borrow) {
+			// оценка оказалась на единицу больше: делитель возвращается
+			digit--;
+			rest[j + v_size] += add_to(rest.data() + j, v_size, divisor.data(), v_size);
+		}
+		quotient[j] = static_cast<Limb>(digit);
+	}
+	shift_right(rest.data(), v_size, shift);
+	if (shift)
+		rest[v_size - 1] |= rest[v_size] << (LimbBits - shift);
+	std::copy(rest.begin(), rest.begin() + v_size, remainder);
+}
+
+// число младших нулевых битов ненулевого числа
+int trailing_zeros(const vector<Limb>& data) {
+	int limb = 0;
+	while (data[limb] == 0)
+		limb++;
+	return limb * LimbBits + __builtin_ctzll(data[limb]);
+}
+
+void shift_right(vector<Limb>& data, int bits) { // NOLINT(runtime/references)
+	int limbs = bits / LimbBits;
+	data.erase(data.begin(), data.begin() + limbs);
+	shift_right(data.data(), static_cast<int>(data.size()), bits % LimbBits);
+	data.resize(trimmed_length(data.data(), static_cast<int>(data.size())));
+}
+
+Limb gcd_limbs(Limb a, Limb b) {
+	if (a == 0 || b == 0)
+		return a | b;
+	int shift = __builtin_ctzll(a | b);
+	a >>= __builtin_ctzll(a);
+	while (b != 0) {
+		b >>= __builtin_ctzll(b);
+		if (a > b)
+			std::swap(a, b);
+		b -= a;
+	}
+	return a << shift;
+}
+} // namespace
+
+BigInt::BigInt() {}
+
+BigInt::BigInt(long long value) : negative(value < 0) {
+	// модуль LLONG_MIN не представим в long long
+	Limb magnitude = negative ? ~static_cast<Limb>(value) + 1 : static_cast<Limb>(value);
+	inline_limbs[0] = magnitude;
+	length = magnitude != 0;
+}
+
+BigInt::BigInt(const BigInt& other) {
+	assign(other.limbs(), other.length, other.negative);
+}
+
+BigInt::BigInt(BigInt&& other) noexcept
+	: negative(other.negative), length(other.length),
+	  heap_limbs(std::move(other.heap_limbs)) {
+	std::copy(other.inline_limbs, other.inline_limbs + InlineLimbs, inline_limbs);
+	other.heap_limbs.clear();
+	other.negative = false;
+	other.length = 0;
+}
+
+BigInt& BigInt::operator=(const BigInt& other) {
+	if (this != &other)
+		assign(other.limbs(), other.length, other.negative);
+	return *this;
+}
+
+BigInt& BigInt::operator=(BigInt&& other) noexcept {
+	if (this == &other)
+		return *this;
+	negative = other.negative;
+	length = other.length;
+	heap_limbs = std::move(other.heap_limbs);
+	std::copy(other.inline_limbs, other.inline_limbs + InlineLimbs, inline_limbs);
+	other.heap_limbs.clear();
+	other.negative = false;
+	other.length = 0;
+	return *this;
+}
+
+Limb* BigInt::limbs() {
+	return heap_limbs.empty() ? inline_limbs : heap_limbs.data();
+}
+
+const Limb* BigInt::limbs() const {
+	return heap_limbs.empty() ? inline_limbs : heap_limbs.data();
+}
+
+void BigInt::reserve(int capacity) {
+	if (heap_limbs.empty()) {
+		if (capacity <= InlineLimbs)
+			return;
+		heap_limbs.assign(inline_limbs, inline_limbs + length);
+	}
+	if (static_cast<int>(heap_limbs.size()) < capacity)
+		heap_limbs.resize(capacity);
+}
+
+void BigInt::trim() {
+	length = trimmed_length(limbs(), length);
+	if (length == 0)
+		negative = false;
+}
+
+void BigInt::assign(const Limb* data, int size, bool is_negative) {
+	// data может указывать в собственные разряды
+	if (size > InlineLimbs || !heap_limbs.empty()) {
+		if (heap_limbs.empty() || data < heap_limbs.data() ||
+			data >= heap_limbs.data() + heap_limbs.size()) {
+			reserve(size);
+			std::copy(data, data + size, limbs());
+		} else {
+			std::copy(data, data + size, heap_limbs.data());
+		}
+	} else {
+		std::copy(data, data + size, inline_limbs);
+	}
+	length = size;
+	negative = is_negative;
+	trim();
+}
+
+int BigInt::compare_magnitude(const BigInt& other) const {
+	return compare_magnitudes(limbs(), length, other.limbs(), other.length);
+}
+
+void BigInt::add_magnitude(const BigInt& other) {
+	int size = std::max(length, other.length);
+	int other_length = other.length;
+	reserve(size + 1);
+	Limb* data = limbs();
+	std::fill(data + length, data + size + 1, 0);
+	// после reserve разряды other перечитываются: other может совпадать с this
+	data[size] = add_to(data, size, other.limbs(), other_length);
+	length = size + 1;
+	trim();
+}
+
+void BigInt::subtract_magnitude(const BigInt& other) {
+	subtract_from(limbs(), length, other.limbs(), other.length);
+	trim();
+}
+
+void BigInt::subtract_from_magnitude(const BigInt& other) {
+	reserve(other.length);
+	Limb* data = limbs();
+	const Limb* subtrahend = other.limbs();
+	Limb borrow = 0;
+	for (int i = 0; i < other.length; i++) {
+		Limb current = i < length ? data[i] : 0;
+		Limb difference = subtrahend[i] - current;
+		Limb next_borrow = subtrahend[i] < current;
+		next_borrow += difference < borrow;
+		data[i] = difference - borrow;
+		borrow = next_borrow;
+	}
+	length = other.length;
+	trim();
+}
+
+void BigInt::add(const BigInt& other, bool other_negative) {
+	if (negative == other_negative) {
+		add_magnitude(other);
+		return;
+	}
+	if (compare_magnitude(other) >= 0) {
+		subtract_magnitude(other);
+	} else {
+		subtract_from_magnitude(other);
+		negative = other_negative;
+	}
+}
+
+BigInt& BigInt::operator+=(const BigInt& other) {
+	add(other, other.negative);
+	return *this;
+}
+
+BigInt& BigInt::operator-=(const BigInt& other) {
+	add(other, !other.negative && other.length != 0);
+	return *this;
+}
+
+BigInt& BigInt::operator*=(const BigInt& other) {
+	bool product_negative = negative != other.negative;
+	if (length == 0 || other.length == 0) {
+		*this = 0;
+		return *this;
+	}
+	if (length == 1 && other.length == 1) {
+		DoubleLimb product = DoubleLimb(limbs()[0]) * other.limbs()[0];
+		Limb halves[2] = {static_cast<Limb>(product), static_cast<Limb>(product >> LimbBits)};
+		assign(halves, 2, product_negative);
+		return *this;
+	}
+	vector<Limb> product(length + other.length);
+	multiply(product.data(), limbs(), length, other.limbs(), other.length);
+	assign(product.data(), static_cast<int>(product.size()), product_negative);
+	return *this;
+}
+
+void BigInt::divide(const BigInt& dividend, const BigInt& divisor, BigInt* quotient,
+					BigInt* remainder) {
+	if (divisor.length == 0)
+		throw std::invalid_argument("BigInt: division by zero");
+	bool quotient_negative = dividend.negative != divisor.negative;
+	bool remainder_negative = dividend.negative;
+	if (dividend.compare_magnitude(divisor) < 0) {
+		if (remainder)
+			*remainder = dividend;
+		if (quotient)
+			*quotient = 0;
+		return;
+	}
+	vector<Limb> quotient_limbs(dividend.length - divisor.length + 1);
+	vector<Limb> remainder_limbs(divisor.length);
+	if (divisor.length == 1) {
+		quotient_limbs.assign(dividend.limbs(), dividend.limbs() + dividend.length);
+		remainder_limbs[0] =
+			divide_by_limb(quotient_limbs.data(), dividend.length, divisor.limbs()[0]);
+	} else {
+		divide_magnitudes(dividend.limbs(),
+						  dividend.length,
+						  divisor.limbs(),
+						  divisor.length,
+						  quotient_limbs.data(),
+						  remainder_limbs.data());
+	}
+	if (quotient)
+		quotient->assign(
+			quotient_limbs.data(), static_cast<int>(quotient_limbs.size()), quotient_negative);
+	if (remainder)
+		remainder->assign(remainder_limbs.data(),
+						  static_cast<int>(remainder_limbs.size()),
+						  remainder_negative);
+}
+
+BigInt& BigInt::operator/=(const BigInt& other) {
+	divide(*this, other, this, nullptr);
+	return *this;
+}
+
+BigInt& BigInt::operator%=(const BigInt& other) {
+	divide(*this, other, nullptr, this);
+	return *this;
+}
+
+BigInt BigInt::operator-() const {
+	BigInt result(*this);
+	if (result.length != 0)
+		result.negative = !result.negative;
+	return result;
+}
+
+BigInt BigInt::operator+(const BigInt& other) const {
+	BigInt result(*this);
+	result += other;
+	return result;
+}
+
+BigInt BigInt::operator-(const BigInt& other) const {
+	BigInt result(*this);
+	result -= other;
+	return result;
+}
+
+BigInt BigInt::operator*(const BigInt& other) const {
+	BigInt result(*this);
+	result *= other;
+	return result;
+}
+
+BigInt BigInt::operator/(const BigInt& other) const {
+	BigInt result;
+	divide(*this, other, &result, nullptr);
+	return result;
+}
+
+BigInt BigInt::operator%(const BigInt& other) const {
+	BigInt result;
+	divide(*this, other, nullptr, &result);
+	return result;
+}
+
+bool BigInt::operator==(const BigInt& other) const {
+	return negative == other.negative && compare_magnitude(other) == 0;
+}
+
+bool BigInt::operator!=(const BigInt& other) const {
+	return !(*this == other);
+}
+
+bool BigInt::operator<(const BigInt& other) const {
+	if (negative != other.negative)
+		return negative;
+	int comparison = compare_magnitude(other);
+	return negative ? comparison > 0 : comparison < 0;
+}
+
+bool BigInt::operator<=(const BigInt& other) const {
+	return !(other < *this);
+}
+
+bool BigInt::operator>(const BigInt& other) const {
+	return other < *this;
+}
+
+bool BigInt::operator>=(const BigInt& other) const {
+	return !(*this < other);
+}
+
+int BigInt::sign() const {
+	return length == 0 ? 0 : (negative ? -1 : 1);
+}
+
+bool BigInt::is_zero() const {
+	return length == 0;
+}
+
+int BigInt::limbs_number() const {
+	return length;
+}
+
+size_t BigInt::digits_number() const {
+	vector<Limb> rest(limbs(), limbs() + length);
+	size_t digits = 0;
+	// пока модуль не меньше 2^64, в нём больше DecimalChunkDigits цифр
+	while (rest.size() > 1) {
+		divide_by_limb(rest.data(), static_cast<int>(rest.size()), DecimalChunk);
+		rest.resize(trimmed_length(rest.data(), static_cast<int>(rest.size())));
+		digits += DecimalChunkDigits;
+	}
+	Limb top = rest.empty() ? 0 : rest[0];
+	do {
+		digits++;
+		top /= 10;
+	} while (top != 0);
+	return digits;
+}
+
+string BigInt::to_string() const {
+	vector<Limb> rest(limbs(), limbs() + length);
+	// десятичные блоки по DecimalChunkDigits цифр, младшими вперёд
+	vector<Limb> chunks;
+	while (!rest.empty()) {
+		chunks.push_back(divide_by_limb(rest.data(), static_cast<int>(rest.size()), DecimalChunk));
+		rest.resize(trimmed_length(rest.data(), static_cast<int>(rest.size())));
+	}
+	if (chunks.empty())
+		return "0";
+	string result = negative ? "-" : "";
+	result += std::to_string(chunks.back());
+	for (int i = static_cast<int>(chunks.size()) - 2; i >= 0; i--) {
+		string chunk = std::to_string(chunks[i]);
+		result += string(DecimalChunkDigits - chunk.size(), '0') + chunk;
+	}
+	return result;
+}
+
+BigInt BigInt::gcd(const BigInt& a, const BigInt& b) {
+	BigInt result;
+	if (a.length == 0 || b.length == 0) {
+		result = a.length == 0 ? b : a;
+		result.negative = false;
+		return result;
+	}
+	vector<Limb> u(a.limbs(), a.limbs() + a.length), v(b.limbs(), b.limbs() + b.length);
+	// gcd(2^k u', 2^l v') = 2^min(k, l) gcd(u', v'), далее из большего нечётного числа
+	// вычитается меньшее, пока числа не поместятся в один разряд
+	int shift = std::min(trailing_zeros(u), trailing_zeros(v));
+	shift_right(u, trailing_zeros(u));
+	while (!v.empty() && (u.size() > 1 || v.size() > 1)) {
+		shift_right(v, trailing_zeros(v));
+		int comparison = compare_magnitudes(
+			u.data(), static_cast<int>(u.size()), v.data(), static_cast<int>(v.size()));
+		if (comparison > 0)
+			std::swap(u, v);
+		subtract_from(v.data(), static_cast<int>(v.size()), u.data(), static_cast<int>(u.size()));
+		v.resize(trimmed_length(v.data(), static_cast<int>(v.size())));
+	}
+	if (!v.empty())
+		u = {gcd_limbs(u[0], v[0])};
+	// результат сдвигается обратно на shift битов
+	vector<Limb> shifted(u.size() + shift / LimbBits + 1);
+	shift_left(shifted.data() + shift / LimbBits, u.data(), static_cast<int>(u.size()),
+			   shift % LimbBits);
+	result.assign(shifted.data(), static_cast<int>(shifted.size()), false);
+	return result;
+}
+
+std::ostream& operator<<(std::ostream& output, const BigInt& value) {
+	return output << value.to_string();
+}
@@ -1,3 +1,5 @@
+#include <utility>
+
 #include "Fraction/Fraction.h"
 
 Fraction::Fraction() {
@@ -5,92 +7,110 @@ Fraction::Fraction() {
 	denominator = 1;
 }
 
-Fraction::Fraction(InfInt n, InfInt d) {
+Fraction::Fraction(BigInt n, BigInt d) {
 	if (d == 0)
 		throw std::invalid_argument("d");
-	numerator = n;
-	denominator = d;
+	numerator = std::move(n);
+	denominator = std::move(d);
 	simplify();
 }
 
 Fraction::~Fraction() {}
 
-Fraction Fraction::operator+(const Fraction& f) {
-	InfInt n = numerator * f.denominator + f.numerator * denominator;
-	InfInt d = denominator * f.denominator;
+Fraction Fraction::operator+(const Fraction& f) const {
+	BigInt n = numerator * f.denominator;
+	n += f.numerator * denominator;
+	BigInt d = denominator * f.denominator;
 
-	Fraction ff(n, d);
+	Fraction ff(std::move(n), std::move(d));
 	return ff;
 }
 
-Fraction Fraction::operator-(const Fraction& f) {
-	InfInt n = numerator * f.denominator - f.numerator * denominator;
-	InfInt d = denominator * f.denominator;
-	last_number_of_digits = n.numberOfDigits() + d.numberOfDigits();
+Fraction Fraction::operator-(const Fraction& f) const {
+	BigInt n = numerator * f.denominator;
+	n -= f.numerator * denominator;
+	BigInt d = denominator * f.denominator;
+	last_number_of_digits = n.digits_number() + d.digits_number();
 
-	Fraction ff(n, d);
+	Fraction ff(std::move(n), std::move(d));
 	return ff;
 }
 
-Fraction Fraction::operator*(const Fraction& f) {
-	InfInt n = numerator * f.numerator;
-	InfInt d = denominator * f.denominator;
+Fraction Fraction::operator*(const Fraction& f) const {
+	BigInt n = numerator * f.numerator;
+	BigInt d = denominator * f.denominator;
 
-	Fraction ff(n, d);
+	Fraction ff(std::move(n), std::move(d));
 	return ff;
 }
 
-Fraction Fraction::operator/(const Fraction& f) {
-	InfInt n = numerator * f.denominator;
-	InfInt d = denominator * f.numerator;
+Fraction Fraction::operator/(const Fraction& f) const {
+	BigInt n = numerator * f.denominator;
+	BigInt d = denominator * f.numerator;
 
-	Fraction ff(n, d);
+	Fraction ff(std::move(n), std::move(d));
 	return ff;
 }
 
 Fraction Fraction::operator+=(const Fraction& f) {
-	numerator = numerator * f.denominator + f.numerator * denominator;
-	denominator = denominator * f.denominator;
+	// f может совпадать с this
+	BigInt cross = f.numerator * denominator;
+	numerator *= f.denominator;
+	numerator += cross;
+	denominator *= f.denominator;
 	simplify();
 
 	return *this;
 }
 
 Fraction Fraction::operator++() {
-	Fraction f(1, 1);
-	numerator = numerator * f.denominator + f.numerator * denominator;
-	denominator = denominator * f.denominator;
-	simplify();
+	// НОД(n + d, d) = НОД(n, d): сокращать не нужно
+	numerator += denominator;
 
 	return *this;
 }
 
 Fraction Fraction::operator++(int) {
-	Fraction ff(numerator, denominator);
-	Fraction f(1, 1);
-	numerator = numerator * f.denominator + f.numerator * denominator;
-	denominator = denominator * f.denominator;
-	simplify();
+	Fraction ff(*this);
+	numerator += denominator;
 
 	return ff;
 }
 
-bool Fraction::operator>(const Fraction& f) {
-	InfInt n = numerator * f.denominator - f.numerator * denominator;
-	return n > 0;
+int Fraction::compare(const Fraction& f) const {
+	// знаменатели положительны: знак дроби - знак числителя
+	int sign = numerator.sign(), other_sign = f.numerator.sign();
+	if (sign != other_sign)
+		return sign < other_sign ? -1 : 1;
+	if (sign == 0)
+		return 0;
+	// произведение чисел из a и b разрядов занимает a + b - 1 или a + b разрядов
+	int left_limbs = numerator.limbs_number() + f.denominator.limbs_number();
+	int right_limbs = f.numerator.limbs_number() + denominator.limbs_number();
+	if (left_limbs > right_limbs + 1)
+		return sign;
+	if (right_limbs > left_limbs + 1)
+		return -sign;
+	BigInt left = numerator * f.denominator;
+	BigInt right = f.numerator * denominator;
+	return left < right ? -1 : (right < left ? 1 : 0);
 }
 
-bool Fraction::operator==(const Fraction& f) {
-	InfInt n = numerator * f.denominator - f.numerator * denominator;
-	return n == 0;
+bool Fraction::operator>(const Fraction& f) const {
+	return compare(f) > 0;
 }
 
-bool Fraction::operator>=(const Fraction& f) {
-	InfInt n = numerator * f.denominator - f.numerator * denominator;
-	return n >= 0;
+bool Fraction::operator==(const Fraction& f) const {
+	return compare(f) == 0;
+}
+
+bool Fraction::operator>=(const Fraction& f) const {
+	return compare(f) >= 0;
 }
 
 std::ostream& operator<<(std::ostream& output, const Fraction& f) {
-	output << "(" << f.numerator << "/" << f.denominator << ")";
+	Fraction reduced(f);
+	reduced.reduction();
+	output << "(" << reduced.numerator << "/" << reduced.denominator << ")";
 	return output;
-}
\ No newline at end of file
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <vector>
+
+// Индекс образцов - слов над номерами букв 0..symbols_number-1 - для проверки, содержит ли
+// текст хотя бы один образец как подслово. Образцы можно добавлять между запросами: они
+// разбиты на группы размером в степени двойки, и для каждой группы построен автомат
+// Ахо-Корасик с полной таблицей переходов. Новый образец образует группу из одного слова,
+// равные по размеру группы сливаются с перестройкой автомата (логарифмический метод).
+// Поэтому каждый образец участвует в O(log n) перестройках, а запрос - это один проход по
+// тексту в каждом из O(log n) автоматов
+class AhoCorasick {
+  private:
+	// группа образцов и её автомат
+	struct Level {
+		// образцы подряд: образец i занимает [starts[i], starts[i + 1]) в symbols
+		std::vector<int> symbols;
+		std::vector<int> starts = {0};
+		// переход из узла node по букве symbol: transitions[node * symbols_number + symbol],
+		// корень - узел 0
+		std::vector<int> transitions;
+		// по суффиксным ссылкам из узла достижим конец образца
+		std::vector<char> terminal;
+
+		int patterns_number() const;
+	};
+
+	int symbols_number;
+	// levels[i] пуст или содержит 2^i образцов
+	std::vector<Level> levels;
+	int patterns_number = 0;
+
+	// строит бор образцов, суффиксные ссылки и недостающие переходы
+	void build(Level&) const; // NOLINT(runtime/references)
+
+  public:
+	explicit AhoCorasick(int symbols_number);
+
+	// бросает std::invalid_argument, если в образце есть буква вне алфавита
+	void add(const std::vector<int>& pattern);
+	// есть ли в text подслово, совпадающее с одним из образцов; буквы text должны быть из
+	// алфавита
+	bool contains_match(const std::vector<int>& text) const;
+	int size() const;
+};
@@ -31,7 +31,7 @@ class AlgExpression : public BaseObject {
 		Symbol symbol; // символ алфавита регулярки или ссылка(&i)
 		int number = 0; // Для указания номера (при линеаризации) в to_glushkov и to_mfa
 						// либо для указания номера ячейки памяти (Type: squareBrL, squareBrL, ref),
-						// чтобы использовать в scan_ref и scan_square_br
+						// чтобы использовать при разборе ссылок и захватов памяти
 		Lexeme(Type type = error, const Symbol& symbol = Symbol(),
 			   int number = 0); // NOLINT(runtime/explicit)
 	};
@@ -86,16 +86,27 @@ class AlgExpression : public BaseObject {
 
 	// возвращаемый тип нижеперечисленных методов зависит от типа объекта (Regex/BackRefRegex)
 	// внутреннее состояние не имеет значения
-	// Построение из вектора лексем дерева регулярного выражения
-	// 2 и 3 аргумент - это начальный и конечный индекс рассматриваемых лексем в векторе
-	virtual AlgExpression* expr(const std::vector<Lexeme>&, int, int) = 0;
-	AlgExpression* scan_conc(const std::vector<Lexeme>&, int, int);
-	AlgExpression* scan_star(const std::vector<Lexeme>&, int, int);
-	AlgExpression* scan_alt(const std::vector<Lexeme>&, int, int);
-	AlgExpression* scan_symb(const std::vector<Lexeme>&, int, int);
-	AlgExpression* scan_eps(const std::vector<Lexeme>&, int, int);
-	AlgExpression* scan_par(const std::vector<Lexeme>&, int, int);
-	static void update_balance(const AlgExpression::Lexeme&, int&);
+	// Построение дерева регулярного выражения из вектора лексем за один проход: спуск по
+	// приоритетам операций (альтернатива, конкатенация, итерация, отрицание, атом), операнды
+	// одной операции собираются в вектор и объединяются правоассоциативно.
+	// pos - индекс первой неразобранной лексемы; при ошибке возвращается nullptr
+	AlgExpression* parse_lexemes(const std::vector<Lexeme>&);
+	AlgExpression* parse_alt(const std::vector<Lexeme>&,
+							 size_t& pos); // NOLINT(runtime/references)
+	AlgExpression* parse_conc(const std::vector<Lexeme>&,
+							  size_t& pos); // NOLINT(runtime/references)
+	AlgExpression* parse_star(const std::vector<Lexeme>&,
+							  size_t& pos); // NOLINT(runtime/references)
+	AlgExpression* parse_negative(const std::vector<Lexeme>&,
+								  size_t& pos); // NOLINT(runtime/references)
+	AlgExpression* parse_atom(const std::vector<Lexeme>&,
+							  size_t& pos); // NOLINT(runtime/references)
+	// атомы, которые есть только у выражений с памятью (ссылки и захваты памяти)
+	virtual AlgExpression* parse_memory(const std::vector<Lexeme>&,
+										size_t& pos); // NOLINT(runtime/references)
+	// объединяет операнды terms правоассоциативной операцией type
+	AlgExpression* join_terms(std::vector<AlgExpression*>& terms, // NOLINT(runtime/references)
+							  Type type) const;
 
 	virtual bool equals(const AlgExpression* other) const = 0;
 
@@ -137,6 +148,9 @@ class AlgExpression : public BaseObject {
 	// возвращает указатель на копию себя
 	virtual AlgExpression* make_copy() const = 0;
 	AlgExpression(const AlgExpression&);
+	// перемещение передаёт поддеревья за O(1), other становится пустым (eps)
+	AlgExpression(AlgExpression&&) noexcept;
+	AlgExpression& operator=(AlgExpression&&) noexcept;
 
 	Symbol get_symbol() const;
 	Type get_type() const;
@@ -153,6 +167,7 @@ class AlgExpression : public BaseObject {
 	void print_dot() const;
 
 	friend class FiniteAutomaton;
+	friend class RegexDAG;
 	friend class Tester;
 	friend class UnitTests;
 };
\ No newline at end of file
@@ -37,9 +37,8 @@ class BackRefRegex : public AlgExpression {
 
 	std::string type_to_str() const override;
 
-	BackRefRegex* expr(const std::vector<Lexeme>&, int, int) override;
-	BackRefRegex* scan_ref(const std::vector<Lexeme>&, int, int);
-	BackRefRegex* scan_square_br(const std::vector<Lexeme>&, int, int);
+	BackRefRegex* parse_memory(const std::vector<Lexeme>&,
+							   size_t& pos) override; // NOLINT(runtime/references)
 
 	bool equals(const AlgExpression* other) const override;
 
@@ -105,7 +104,9 @@ class BackRefRegex : public AlgExpression {
 
 	BackRefRegex* make_copy() const override;
 	BackRefRegex(const BackRefRegex&);
+	BackRefRegex(BackRefRegex&&) noexcept = default;
 	BackRefRegex& operator=(const BackRefRegex& other);
+	BackRefRegex& operator=(BackRefRegex&&) noexcept = default;
 
 	// dynamic_cast к типу BackRefRegex*
 	template <typename T> static BackRefRegex* cast(T* ptr, bool not_null_ptr = true);
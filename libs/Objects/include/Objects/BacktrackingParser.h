@@ -0,0 +1,73 @@
+#pragma once
+#include <set>
+#include <stack>
+#include <string>
+#include <tuple>
+#include <utility>
+
+// Разбор слова с откатами (поиск в глубину по парам (позиция в слове, состояние)), общий для
+// FiniteAutomaton::parse и FrozenAutomaton::parse: представления автомата различаются только
+// способом найти переходы, поэтому число шагов у них совпадает.
+// is_terminal(state) - финальность состояния, transitions(state, c) - состояния, в которые
+// ведут переходы из state по букве c, epsilon_transitions(state) - по eps. Переходы
+// перебираются в порядке возрастания номеров состояний.
+// Возвращает число шагов и принадлежность слова языку
+template <typename IsTerminal, typename Transitions, typename EpsilonTransitions>
+std::pair<int, bool> parse_with_backtracking(int initial_state, const std::string& s,
+											 IsTerminal is_terminal, Transitions transitions,
+											 EpsilonTransitions epsilon_transitions) {
+	struct ParingState {
+		int pos;
+		int state;
+
+		ParingState(int pos, int state) : pos(pos), state(state) {}
+	};
+	// Пара (актуальный индекс элемента в строке, состояние)
+	std::stack<ParingState> stack_state;
+	// Тройка (актуальный индекс элемента в строке, начало эпсилон-перехода, конец эпсилон-перехода)
+	std::set<std::tuple<int, int, int>> visited_eps;
+	int counter = 0;
+	int parsed_len = 0;
+	int state = initial_state;
+	stack_state.emplace(parsed_len, state);
+	while (!stack_state.empty()) {
+		if (is_terminal(state) && parsed_len == s.size()) {
+			break;
+		}
+		counter++;
+		state = stack_state.top().state;
+		parsed_len = stack_state.top().pos;
+		stack_state.pop();
+		// Переходы в новые состояния по очередному символу строки
+		if (parsed_len < s.size()) {
+			for (int to : transitions(state, s[parsed_len])) {
+				stack_state.emplace(parsed_len + 1, to);
+			}
+		}
+
+		// Если произошёл откат по строке, то эпсилон-переходы из рассмотренных состояний больше не
+		// считаются повторными
+		if (!visited_eps.empty()) {
+			std::set<std::tuple<int, int, int>> temp_eps;
+			for (auto pos : visited_eps) {
+				if (std::get<0>(pos) <= parsed_len)
+					temp_eps.insert(pos);
+			}
+			visited_eps = temp_eps;
+		}
+		// Добавление тех эпсилон-переходов, по которым ещё не было разбора от этой позиции и этого
+		// состояния
+		for (int eps_to : epsilon_transitions(state)) {
+			if (!visited_eps.count({parsed_len, state, eps_to})) {
+				stack_state.emplace(parsed_len, eps_to);
+				visited_eps.insert({parsed_len, state, eps_to});
+			}
+		}
+	}
+
+	if (s.size() == parsed_len && is_terminal(state)) {
+		return {counter, true};
+	}
+
+	return {counter, false};
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Сопоставление слова с автоматом Глушкова битово-параллельным методом (Navarro, Raffinot).
+// В автомате Глушкова все переходы в позицию идут по её символу, поэтому шаг разбора -
+// D' = Follow(D) & B[c], где D - маска активных позиций, B[c] - маска позиций с символом c.
+// Follow(D) вычисляется по таблицам для каждого байта маски: Follow(D) - объединение
+// follow_table[k][k-й байт D]. Позиция 0 - начальное состояние
+class BitParallelMatcher {
+  public:
+	using Mask = uint64_t;
+
+  private:
+	int positions_number;
+	// количество слов Mask в маске позиций
+	int words_number;
+	// количество байтов в маске позиций
+	int chunks_number;
+
+	// маска позиций символа c начинается с c * words_number
+	std::vector<Mask> symbol_masks;
+	// маска Follow для байта value k-го байта маски начинается с
+	// (k * 256 + value) * words_number
+	std::vector<Mask> follow_table;
+	std::vector<Mask> final_mask;
+
+  public:
+	// follow[i] - позиции, следующие за позицией i (для 0 - начальные позиции);
+	// symbols[i] - однобуквенный символ позиции i > 0 (позиции с другими символами
+	// недостижимы); final_positions - позиции, в которых слово допускается
+	BitParallelMatcher(const std::vector<std::vector<int>>& follow,
+					   const std::vector<std::string>& symbols,
+					   const std::vector<int>& final_positions);
+
+	int size() const;
+	bool parse(const std::string&) const;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class FiniteAutomaton;
+
+// Одновременная симуляция НКА без откатов: множество текущих состояний хранится битовой маской.
+// Для каждой пары (состояние, символ), у которой есть переходы, в конструкторе один раз
+// строится маска состояний, достижимых по символу с последующим eps-замыканием, после чего
+// объект разбирает любое число слов.
+// Шаг разбора - объединение масок активных состояний, у которых есть переходы по символу:
+// O(k * |Q| / 64), где k - число таких состояний, т.е. O(|Q|^2 / 64) на символ слова в худшем
+// случае. Переходы произвольного НКА не сводятся к сдвигам масок; для автомата Глушкова
+// шаг дешевле (BitParallelMatcher).
+// Память - O(|Q| * |Σ|) номеров масок и O(P * |Q| / 64) слов для P пар с переходами
+class BitsetSimulator {
+  public:
+	using Mask = uint64_t;
+
+  private:
+	// у пары (состояние, символ) нет переходов
+	inline static const int NoMask = -1;
+
+	int states_number;
+	int symbols_number;
+	// количество слов Mask в маске множества состояний
+	int words_number;
+	// номера однобуквенных символов (FrozenAutomaton::get_char_id)
+	std::array<int, 256> char_ids;
+
+	std::vector<Mask> initial;
+	std::vector<Mask> terminal;
+	// маска состояний с переходами по symbol_id начинается с symbol_id * words_number
+	std::vector<Mask> has_transitions;
+	// номер маски переходов из state по symbol_id: mask_ids[symbol_id * states_number + state]
+	std::vector<int> mask_ids;
+	// маска с номером mask_id начинается с mask_id * words_number
+	std::vector<Mask> successors;
+
+  public:
+	explicit BitsetSimulator(const FiniteAutomaton&);
+
+	// возвращает число пар (позиция в слове, активное состояние), рассмотренных при разборе,
+	// и принадлежность слова языку
+	std::pair<int, bool> parse(const std::string&) const;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+
+#include "RegexDAG.h"
+
+// ДКА Бжозовского, который строится по регулярке по ходу разбора слов: состояния - производные
+// исходного выражения в RegexDAG, переход вычисляется при первом обращении и сохраняется.
+// Нормализация в RegexDAG делает множество производных конечным, а строятся только
+// состояния, достижимые на разобранных словах. Отрицание ^ не требует построения
+// дополнения: производная ^r - это ^ от производной r.
+// Буквы вне алфавита языка регулярки ведут в пустое состояние
+class BrzozowskiDFA {
+  private:
+	// переход ещё не вычислен
+	inline static const int Unknown = -1;
+
+	RegexDAG dag;
+	// однобуквенные символы алфавита
+	std::vector<Symbol> symbols;
+	// номер символа для байта; -1 - байт вне алфавита
+	std::array<int, 256> char_ids;
+
+	std::vector<const RegexDAG::Node*> states;
+	// номер состояния по номеру ноды (-1 - нода не состояние)
+	std::vector<int> state_index;
+	// переход из state по symbol_id хранится в transitions[state * symbols.size() + symbol_id]
+	std::vector<int> transitions;
+	int dead_state;
+
+	int add_state(const RegexDAG::Node*);
+
+  public:
+	explicit BrzozowskiDFA(const Regex&);
+
+	int get_initial() const;
+	int next(int state, char c);
+	bool is_accepting(int state) const;
+	// пустое множество: слово нельзя продолжить до допускаемого
+	bool is_dead(int state) const;
+
+	bool parse(const std::string&);
+
+	// число построенных состояний
+	int states_number() const;
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+
+#include "FrozenAutomaton.h"
+
+class FiniteAutomaton;
+
+// Индекс eps-замыканий всех состояний автомата. Граф eps-переходов сжимается в компоненты
+// сильной связности (алгоритм Тарьяна): у состояний одной компоненты общее замыкание, поэтому
+// оно хранится один раз на компоненту и строится слиянием замыканий компонент, в которые ведут
+// eps-переходы (Тарьян выдаёт их раньше)
+class EpsilonClosures {
+  private:
+	// eps-переходы из state лежат в epsilon_targets на отрезке
+	// [epsilon_offsets[state], epsilon_offsets[state + 1])
+	std::vector<int> epsilon_offsets;
+	std::vector<int> epsilon_targets;
+	// номер компоненты сильной связности состояния
+	std::vector<int> components;
+	// отсортированные замыкания компонент
+	std::vector<std::vector<int>> closures;
+
+	void build();
+
+  public:
+	explicit EpsilonClosures(const FiniteAutomaton&);
+	explicit EpsilonClosures(const FrozenAutomaton&);
+
+	int size() const;
+	// eps-замыкание state (отсортированное, вместе с самим состоянием)
+	const std::vector<int>& get(int state) const;
+	int get_component(int state) const;
+	int components_number() const;
+};
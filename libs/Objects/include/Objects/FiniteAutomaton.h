@@ -13,15 +13,19 @@
 #include <vector>
 
 #include "AbstractMachine.h"
+#include "FoolingSetSearch.h"
+#include "FrozenAutomaton.h"
 #include "MemoryCommon.h"
 #include "iLogTemplate.h"
 
 class Regex;
+class EpsilonClosures;
 class MetaInfo;
 class Language;
 class MFAState;
 class TransformationMonoid;
 class MemoryFiniteAutomaton;
+class Partition;
 
 class FAState : public State {
   public:
@@ -47,6 +51,59 @@ class FAState : public State {
 	void add_transition(int, const Symbol&);
 };
 
+// Состояния конечного автомата вместе с индексом eps-замыканий, построенным по ним. Любой
+// неконстантный доступ к состояниям, в том числе из друзей FiniteAutomaton, сбрасывает индекс,
+// поэтому изменить переходы, не сбросив его, нельзя. Константный доступ индекс сохраняет.
+// Копии индекс не наследуют. Индекс читается и записывается атомарными операциями над
+// shared_ptr, поэтому константный автомат можно разбирать из разных потоков; неконстантный
+// доступ, как и у std::vector, не должен пересекаться с другими обращениями
+class FAStates {
+  private:
+	std::vector<FAState> states;
+	mutable std::shared_ptr<const EpsilonClosures> epsilon_closures;
+
+	void invalidate();
+
+  public:
+	FAStates() = default;
+	FAStates(std::vector<FAState> states); // NOLINT(runtime/explicit)
+	FAStates(const FAStates& other);
+	FAStates(FAStates&& other) noexcept;
+	FAStates& operator=(const FAStates& other);
+	FAStates& operator=(FAStates&& other) noexcept;
+	FAStates& operator=(std::vector<FAState> other);
+
+	operator const std::vector<FAState>&() const; // NOLINT(runtime/explicit)
+	size_t size() const;
+	bool empty() const;
+	const FAState& operator[](size_t index) const;
+	const FAState& back() const;
+	std::vector<FAState>::const_iterator begin() const;
+	std::vector<FAState>::const_iterator end() const;
+
+	// неконстантные методы сбрасывают индекс eps-замыканий
+	FAState& operator[](size_t index);
+	FAState& back();
+	std::vector<FAState>::iterator begin();
+	std::vector<FAState>::iterator end();
+	void push_back(FAState state);
+	template <typename... Args> FAState& emplace_back(Args&&... args) {
+		invalidate();
+		return states.emplace_back(std::forward<Args>(args)...);
+	}
+	void pop_back();
+	void resize(size_t size);
+	void reserve(size_t size);
+	void clear();
+	std::vector<FAState>::iterator erase(std::vector<FAState>::const_iterator position);
+	std::vector<FAState>::iterator erase(std::vector<FAState>::const_iterator first,
+										 std::vector<FAState>::const_iterator last);
+
+	// eps-замыкания состояний автомата fa, которому принадлежат состояния (строятся при
+	// первом обращении)
+	std::shared_ptr<const EpsilonClosures> get_epsilon_closures(const FiniteAutomaton& fa) const;
+};
+
 // TODO если меняешь структуру, поменяй FA_model в TransformationMonoid.h
 class FiniteAutomaton : public AbstractMachine {
   public:
@@ -54,11 +111,14 @@ class FiniteAutomaton : public AbstractMachine {
 		exponentially_ambiguous,
 		almost_unambigious,
 		unambigious,
-		polynomially_ambigious
+		polynomially_ambigious,
+		// число успешных путей для слов ограничено константой (только structural_ambiguity)
+		finitely_ambiguous
 	};
 
   private:
-	std::vector<FAState> states;
+	// состояния и индекс eps-замыканий, который сбрасывается при их изменении
+	FAStates states;
 
 	// Если режим isTrim включён (т.е. по умолчанию), то на всех подозрительных
 	// преобразованиях всегда удаляем в конце ловушки.
@@ -73,12 +133,40 @@ class FiniteAutomaton : public AbstractMachine {
 	// eps-переходам (если флаг установлен в 0 - по всем переходам)
 	std::set<int> closure(const std::set<int>&, bool) const;
 
-	std::vector<int> get_bisimulation_classes() const;
+	// операция над языками, которая определяет финальные состояния произведения автоматов
+	enum ProductOperation {
+		product_intersection,
+		product_union,
+		product_difference,
+	};
+	// произведение ДКА, полученных определизацией fa1 и fa2 над объединением их алфавитов.
+	// Строятся только пары, достижимые из пары начальных состояний
+	static FiniteAutomaton get_product(const FiniteAutomaton& fa1, const FiniteAutomaton& fa2,
+									   ProductOperation operation);
+
+	// разбиение состояний на классы бисимуляции: алгоритм Пейджа-Тарьяна для размеченных
+	// систем переходов (переходы по eps рассматриваются как переходы по символу), O(m * log n)
+	static Partition get_bisimulation_partition(const FrozenAutomaton&);
+	// классы бисимуляции в нумерации RLGrammar::get_bisimilar_grammar (классы упорядочены по
+	// множествам правил, построенным из номеров классов предыдущего шага уточнения);
+	// initial_class - номер всех состояний перед первым шагом уточнения
+	std::vector<int> get_bisimulation_classes(int initial_class = 0) const;
+	// классы эквивалентных состояний полного ДКА в нумерации, которую использует minimize:
+	// сначала неодноэлементные классы по возрастанию второго по величине состояния,
+	// затем одноэлементные по возрастанию состояния.
+	// Алгоритм заполнения таблицы, O(n^2 * |alphabet|) памяти и времени на проход
+	std::vector<int> get_table_filling_classes() const;
+	// Алгоритм Хопкрофта, O(n * |alphabet| * log n)
+	std::vector<int> get_hopcroft_classes() const;
 	// объединение эквивалентных классов (принимает на вход вектор размера states.size())
 	// на i-й позиции номер класса i-го состояния
 	std::tuple<FiniteAutomaton, std::unordered_map<int, int>> merge_classes(
 		const std::vector<int>&) const;
 	static bool equality_checker(const FiniteAutomaton& fa1, const FiniteAutomaton& fa2);
+	// несвязное объединение автоматов: состояния fa2 нумеруются после состояний fa1,
+	// начальное состояние - начальное состояние fa1, язык - язык fa1
+	static FiniteAutomaton get_disjoint_union(const FiniteAutomaton& fa1,
+											  const FiniteAutomaton& fa2);
 	// дополнительно возвращает в векторах номера классов состояний каждого автомата
 	static std::tuple<bool, std::pair<MetaInfo, MetaInfo>, std::vector<std::vector<int>>>
 	bisimilarity_checker(const FiniteAutomaton& fa1, const FiniteAutomaton& fa2);
@@ -88,6 +176,10 @@ class FiniteAutomaton : public AbstractMachine {
 		int digits_number_limit,
 		std::optional<int>& word_length) // NOLINT(runtime/references)
 		const;
+	// структурные критерии Вебера-Зайдля в формулировке Аллозена-Мори-Растоги на полезной
+	// части автомата без eps-переходов: однозначность и EDA проверяются по компонентам сильной
+	// связности A^2, IDA - по компонентам сильной связности A^3. Полиномиальное время
+	AmbiguityValue get_structural_ambiguity_value() const;
 	std::optional<bool> get_nfa_minimality_value() const;
 
 	// поиск префикса из состояния state_beg в состояние state_end
@@ -132,6 +224,10 @@ class FiniteAutomaton : public AbstractMachine {
 
 	std::vector<FAState> get_states() const;
 	size_t size(iLogTemplate* log = nullptr) const override;
+	// неизменяемый снимок переходов в формате CSR для алгоритмов, не меняющих автомат
+	FrozenAutomaton freeze() const;
+	// eps-замыкания состояний (строятся при первом обращении)
+	std::shared_ptr<const EpsilonClosures> get_epsilon_closures() const;
 
 	// детерминизация ДКА
 	FiniteAutomaton determinize(bool is_trim = false, iLogTemplate* log = nullptr) const;
@@ -177,6 +273,10 @@ class FiniteAutomaton : public AbstractMachine {
 	// проверка автоматов на эквивалентность
 	static bool equivalent(const FiniteAutomaton&, const FiniteAutomaton&,
 						   iLogTemplate* log = nullptr);
+	// кратчайшее слово, принадлежащее языку ровно одного из автоматов, или nullopt, если языки
+	// совпадают. Алгоритм Хопкрофта-Карпа на лениво определизированных автоматах
+	static std::optional<std::string> find_equivalence_counterexample(const FiniteAutomaton&,
+																	  const FiniteAutomaton&);
 	// проверка автоматов на равенство(буквальное)
 	static bool equal(const FiniteAutomaton&, const FiniteAutomaton&, iLogTemplate* log = nullptr);
 	// проверка автоматов на бисимилярность
@@ -185,21 +285,43 @@ class FiniteAutomaton : public AbstractMachine {
 	bool is_deterministic(iLogTemplate* log = nullptr) const override;
 	// проверка НКА на семантический детерминизм
 	bool semdet(iLogTemplate* log = nullptr) const;
+	// разбор с откатами прямо по переходам автомата, без предварительных построений; при
+	// разборе многих слов снимок freeze() строится один раз (FrozenAutomaton::parse)
 	std::pair<int, bool> parse(const std::string&) const override;
+	// принадлежность языку каждого слова пакета (результаты совпадают с parse): разбор по
+	// плоской таблице ДКА (FlatDFA) с чередованием слов, пакет делится между потоками
+	// (threads_number = 0 - по числу ядер). ДКА строится при каждом вызове; для многих
+	// пакетов FlatDFA строится один раз и разбирает их сам
+	std::vector<bool> parse_batch(const std::vector<std::string>& words,
+								  int threads_number = 0) const;
 	// проверка автоматов на вложенность (проверяет вложен ли аргумент в this)
 	bool subset(const FiniteAutomaton&, iLogTemplate* log = nullptr) const;
+	// слово из языка аргумента, не принадлежащее языку this, или nullopt, если аргумент вложен
+	// в this. Антицепной алгоритм (De Wulf, Doyen, Henzinger, Raskin): this определизируется
+	// лениво, поиск останавливается на первом (кратчайшем) контрпримере
+	std::optional<std::string> find_subset_counterexample(const FiniteAutomaton&) const;
 	// определяет меру неоднозначности
 	AmbiguityValue ambiguity(iLogTemplate* log = nullptr) const;
+	// степень неоднозначности по Веберу-Зайдлю (число успешных путей для слова длины k):
+	// EDA - exponentially_ambiguous, IDA без EDA - polynomially_ambigious, ограниченная
+	// неоднозначность - finitely_ambiguous. В отличие от ambiguity, которая сравнивает число
+	// путей с числом слов, не учитывает долю неоднозначных слов: для автомата Глушкова
+	// (a|b|c)*(d|d)*(a|b|c|d)* ambiguity - almost_unambigious, а здесь - exponentially_ambiguous
+	AmbiguityValue structural_ambiguity(iLogTemplate* log = nullptr) const;
 	// проверка на детерминированность методом орбит Брюггеманн-Вуда
 	bool is_one_unambiguous(iLogTemplate* log = nullptr) const;
 	// проверка на пустоту
 	bool is_empty() const;
+	// проверка на универсальность (распознаются все слова над алфавитом)
+	bool is_universal() const;
 	// проверка автомата на финальность
 	bool is_finite() const;
 	// метод Arden
 	Regex to_regex(iLogTemplate* log = nullptr) const;
-	// возвращает число диагональных классов по методу Глейстера-Шаллита
-	int get_classes_number_GlaisterShallit(iLogTemplate* log = nullptr) const;
+	// возвращает число диагональных классов по методу Глейстера-Шаллита; если перебор
+	// прерван по бюджету options, возвращается наибольшее найденное число (оценка снизу)
+	int get_classes_number_GlaisterShallit(
+		iLogTemplate* log = nullptr, const FoolingSetSearch::Options& options = {}) const;
 	// построение синтаксического моноида по автомату
 	TransformationMonoid get_syntactic_monoid() const;
 	// проверка на минимальность для нка
@@ -209,8 +331,11 @@ class FiniteAutomaton : public AbstractMachine {
 	MemoryFiniteAutomaton to_mfa() const;
 
 	friend class Regex;
+	friend class FrozenAutomaton;
+	friend class EpsilonClosures;
 	friend class MemoryFiniteAutomaton;
 	friend class MetaInfo;
 	friend class RLGrammar;
 	friend class PrefixGrammar;
+	friend class UnitTests;
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "BitsetSimulator.h"
+
+class FiniteAutomaton;
+
+// ДКА с плоской таблицей переходов, построенный определизацией FiniteAutomaton.
+// Байты слова разбиваются на классы: байты однобуквенных символов автомата получают
+// собственные классы, все остальные байты - общий класс, ведущий в пустое макросостояние.
+// Состояния хранятся как смещения строк таблицы (номер состояния * число классов), поэтому
+// переход - одно чтение table[state + byte_classes[c]].
+// Определизация ограничена states_limit состояниями: если ДКА больше, таблица не строится и
+// слова разбираются одновременной симуляцией НКА (BitsetSimulator). Объект можно построить
+// один раз и разбирать им любое число пакетов
+class FlatDFA {
+  public:
+	inline static const int DefaultStatesLimit = 16384;
+
+  private:
+	int classes_number;
+	std::array<int32_t, 256> byte_classes;
+	int32_t initial;
+	std::vector<int32_t> table;
+	// допустимость по номеру состояния (смещение / classes_number)
+	std::vector<char> accepting;
+	// симуляция НКА, если определизация превысила ограничение
+	std::optional<BitsetSimulator> fallback;
+
+	// разбор слов words[first, last) с чередованием нескольких слов за шаг
+	void parse_range(const std::vector<std::string>& words, int first, int last,
+					 std::vector<char>& results) const; // NOLINT(runtime/references)
+
+  public:
+	explicit FlatDFA(const FiniteAutomaton&, int states_limit = DefaultStatesLimit);
+
+	// построена ли таблица ДКА (иначе разбор идёт по BitsetSimulator)
+	bool is_determinized() const;
+	// число состояний ДКА (0, если таблица не построена)
+	int size() const;
+	bool parse(const std::string&) const;
+	// результаты совпадают с parse для каждого слова; слова делятся между потоками
+	// (threads_number = 0 - по числу ядер)
+	std::vector<bool> parse_batch(const std::vector<std::string>& words,
+								  int threads_number = 0) const;
+};
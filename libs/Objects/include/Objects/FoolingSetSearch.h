@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Поиск наибольшего расширенного обманывающего множества по таблице Майхилла-Нерода
+// (оценка Глейстера-Шаллита снизу на число состояний НКА): пары (строка r_i, столбец c_i),
+// i = 1..k, такие что table[r_i][c_i] = 1 и table[r_i][c_j] = 0 при i < j.
+// Выбор пары зависит только от строки: она вычёркивает все столбцы, где у неё единицы, поэтому
+// состояние перебора - множества оставшихся строк и столбцов (битовые строки). Перебор
+// ветвей и границ:
+//  - строка с единственной единицей выбирается сразу, столбец с единственной единицей
+//    отходит в конец последовательности вместе со своей строкой;
+//  - ветвление только по строкам, минимальным по включению единиц (остальные доминируются);
+//  - верхняя оценка по числу строк и столбцов и по числам нулей в них: i-я строка
+//    последовательности длины k содержит не меньше k - i нулей, i-й столбец - не меньше i - 1;
+//  - состояния, уже пройденные на той же или большей глубине, не обходятся повторно.
+// Ветви первого уровня могут делиться между потоками; бюджет по числу узлов и времени
+// прерывает перебор, и тогда результат - наибольшее найденное множество
+class FoolingSetSearch {
+  public:
+	struct Options {
+		// 0 - без ограничения
+		long long max_nodes = 0;
+		int time_limit_ms = 0;
+		// 0 - по числу ядер
+		int threads_number = 1;
+	};
+
+	struct Result {
+		// (строка, столбец) в порядке, где выше диагонали нули
+		std::vector<std::pair<int, int>> pairs;
+		// перебор завершён, и pairs - наибольшее множество
+		bool complete = true;
+		long long nodes_number = 0;
+	};
+
+  private:
+	using Word = uint64_t;
+	class Searcher;
+
+	int rows_number;
+	int columns_number;
+	int row_words;
+	int column_words;
+	// единицы строк по столбцам и столбцов по строкам
+	std::vector<Word> row_bits;
+	std::vector<Word> column_bits;
+
+  public:
+	explicit FoolingSetSearch(const std::vector<std::vector<bool>>& table);
+
+	Result run(const Options&) const;
+};
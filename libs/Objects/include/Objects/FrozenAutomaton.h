@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Symbol.h"
+
+class FiniteAutomaton;
+
+// Неизменяемый снимок переходов FiniteAutomaton в формате CSR.
+// Символы получают плотные номера: сначала символы алфавита языка (в порядке Alphabet),
+// затем символы, встречающиеся только на переходах (eps и т.п.).
+// Переходы состояния state - пары (символ, состояние) на отрезке [offsets[state],
+// offsets[state + 1]) массивов labels и targets, упорядоченные по номеру символа, поэтому
+// память - O(|Q| + число переходов) независимо от размера алфавита, а переходы по символу
+// находятся двоичным поиском внутри строки состояния.
+// Снимок строится за O(|Q| + число переходов); алгоритмы, которые обращаются к нему многократно
+// (например, разбирают много слов), должны строить его один раз
+class FrozenAutomaton {
+  public:
+	// номер символа, которого нет в снимке
+	inline static const int NoSymbol = -1;
+
+	// отрезок массива состояний, в которые ведут переходы
+	class Targets {
+	  private:
+		const int* first;
+		const int* last;
+
+	  public:
+		Targets(const int* first, const int* last);
+
+		const int* begin() const;
+		const int* end() const;
+		int size() const;
+		bool empty() const;
+		// первое состояние (для детерминированных переходов)
+		int front() const;
+	};
+
+  private:
+	int initial_state = 0;
+	int states_number = 0;
+	// количество символов алфавита языка (они идут первыми)
+	int alphabet_size = 0;
+	int epsilon_id = NoSymbol;
+
+	std::vector<Symbol> symbols;
+	std::unordered_map<Symbol, int, Symbol::Hasher> symbol_ids;
+	// номера однобуквенных символов, по которым разбираются слова
+	std::array<int, 256> char_ids;
+
+	std::vector<int> offsets;
+	std::vector<int> labels;
+	std::vector<int> targets;
+	std::vector<char> terminal;
+
+  public:
+	explicit FrozenAutomaton(const FiniteAutomaton&);
+
+	int size() const;
+	int get_initial() const;
+	bool is_terminal(int state) const;
+
+	// количество символов в снимке (алфавит + символы только на переходах)
+	int symbols_number() const;
+	// символы с номерами [0, get_alphabet_size()) образуют алфавит языка
+	int get_alphabet_size() const;
+	const Symbol& get_symbol(int symbol_id) const;
+	int get_symbol_id(const Symbol&) const;
+	// номер символа, состоящего из одной буквы c
+	int get_char_id(char c) const;
+	int get_epsilon_id() const;
+
+	// переходы из state по символу с номером symbol_id
+	Targets get_transitions(int state, int symbol_id) const;
+	// все переходы из state (по всем символам)
+	Targets get_transitions(int state) const;
+	// число переходов
+	int transitions_number() const;
+
+	// разбор слова с откатами, как FiniteAutomaton::parse (то же число шагов)
+	std::pair<int, bool> parse(const std::string&) const;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EpsilonClosures.h"
+#include "FrozenAutomaton.h"
+#include "SubsetTable.h"
+
+class FiniteAutomaton;
+
+// ДКА, который строится по НКА по ходу разбора слов (как в RE2): макросостояния и переходы
+// между ними вычисляются при первом обращении и сохраняются в кэше. Кэш ограничен числом
+// макросостояний; при переполнении он очищается, и построение продолжается с текущего
+// макросостояния. Повторные запросы к одному объекту работают со скоростью ДКА, а полная
+// определизация не выполняется.
+// Неякорный автомат (unanchored) распознаёт язык Σ*·L: на каждом шаге к макросостоянию
+// добавляется замыкание начального состояния, а байты вне алфавита не обрывают разбор.
+// Его допускающие макросостояния отмечают концы вхождений слов языка в текст
+class LazyDFA {
+  public:
+	inline static const int DefaultCacheLimit = 4096;
+
+  private:
+	// переход ещё не вычислен
+	inline static const int Unknown = -1;
+
+	FrozenAutomaton frozen;
+	std::shared_ptr<const EpsilonClosures> closures;
+	int symbols_number;
+	// номера однобуквенных символов (FrozenAutomaton::get_char_id); байтам, которых нет
+	// в автомате, соответствует общий столбец other_symbol() таблицы переходов
+	std::array<int, 256> char_ids;
+	bool unanchored;
+	int cache_limit;
+	int flushes_number = 0;
+
+	SubsetTable macrostates;
+	std::vector<char> accepting;
+	// пустые макросостояния
+	std::vector<char> dead;
+	// переход из macrostate по symbol_id хранится в transitions[macrostate * row_size() +
+	// symbol_id]
+	std::vector<int> transitions;
+
+	// буфер для вычисления подмножеств
+	std::vector<int> subset;
+	std::vector<int> visited;
+	int stamp = 0;
+
+	int other_symbol() const;
+	int row_size() const;
+	// добавляет подмножество subset, очищая кэш при переполнении
+	int add_macrostate();
+	void flush();
+
+  public:
+	explicit LazyDFA(const FiniteAutomaton&, int cache_limit = DefaultCacheLimit,
+					 bool unanchored = false);
+
+	// номера макросостояний действительны до следующей очистки кэша; она может произойти
+	// в get_initial и next, поэтому сохранять можно только последний полученный номер
+	int get_initial();
+	int next(int macrostate, char c);
+	// разбор data[0, size) из macrostate до конца или до пустого макросостояния; возвращает
+	// последнее макросостояние, в accepted_length - длину наибольшего допускаемого префикса
+	// data (-1, если такого нет)
+	int run(int macrostate, const char* data, size_t size,
+			int64_t& accepted_length); // NOLINT(runtime/references)
+	// то же, в read_length - число прочитанных букв
+	int run(int macrostate, const char* data, size_t size,
+			int64_t& accepted_length, // NOLINT(runtime/references)
+			size_t& read_length);	  // NOLINT(runtime/references)
+	// разбор data[0, size) из macrostate до первого допускающего макросостояния; возвращает
+	// число прочитанных букв (size, если допускающее макросостояние не встретилось), в
+	// macrostate - последнее макросостояние
+	size_t run_to_accepting(int& macrostate, // NOLINT(runtime/references)
+							const char* data, size_t size);
+	bool is_accepting(int macrostate) const;
+	// пустое макросостояние: слово нельзя продолжить до допускаемого
+	bool is_dead(int macrostate) const;
+
+	bool parse(const std::string&);
+
+	// число макросостояний в кэше и число очисток кэша
+	int cached_states_number() const;
+	int get_flushes_number() const;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "LazyDFA.h"
+
+class FiniteAutomaton;
+
+// Поиск вхождений слов языка автомата в текст (как grep -o): находится самое левое непустое
+// вхождение, среди них - самое длинное, затем поиск продолжается с его конца.
+// Перед запуском автоматов текст пропускается до возможного начала вхождения: до
+// обязательного префикса слов языка (memchr по его самому редкому байту и сравнение) или до
+// байта, с которого может начаться слово. Неякорный ДКА (Σ*·L) находит конец самого раннего
+// вхождения, после чего самое левое начало ищется якорным ДКА лишь среди позиций перед ним.
+// Если якорные прогоны, не нашедшие вхождения, прочитали больше букв, чем осталось в тексте
+// (на тексте вида a...ac для a*b|c это давало квадратичное время), начала всех вхождений до
+// конца текста отмечаются одним обратным проходом неякорного ДКА языка L^R без пустого слова
+// (как в RE2), и дальше самое левое начало берётся из отметок за линейное время
+class MatchSearcher {
+  public:
+	// смещение и длина вхождения
+	using Match = std::pair<size_t, size_t>;
+
+  private:
+	LazyDFA anchored;
+	LazyDFA unanchored;
+	// неякорный ДКА языка (L \ {ε})^R: допускающие макросостояния при чтении текста справа
+	// налево отмечают начала непустых вхождений
+	LazyDFA reversed;
+	// пустое слово допускается: неякорный ДКА не отличает его вхождения от непустых
+	bool accepts_empty;
+	// все непустые слова языка начинаются с prefix; memchr ищет prefix[rare_index]
+	std::string prefix;
+	size_t rare_index = 0;
+	// байты, с которых могут начинаться непустые слова языка
+	std::array<bool, 256> first_bytes;
+	int first_bytes_number = 0;
+
+	// ближайшая к position позиция, с которой может начаться вхождение (size, если такой нет)
+	size_t skip(const char* data, size_t size, size_t position) const;
+	// starts[i - from] - с позиции i (from <= i < size) начинается непустое вхождение
+	void mark_starts(const char* data, size_t size, size_t from,
+					 std::vector<bool>& starts); // NOLINT(runtime/references)
+
+  public:
+	explicit MatchSearcher(const FiniteAutomaton&);
+
+	std::vector<Match> search(const char* data, size_t size);
+	std::vector<Match> search(const std::string&);
+	// файл отображается в память (mmap); на платформах без mmap он читается целиком
+	std::vector<Match> search_file(const std::string& path);
+
+	const std::string& get_prefix() const;
+};
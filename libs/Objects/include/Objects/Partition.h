@@ -0,0 +1,36 @@
+#pragma once
+#include <utility>
+#include <vector>
+
+// Уточняемое разбиение множества {0, ..., n - 1} на блоки (Valmari, Lehtinen).
+// Элементы каждого блока лежат в массиве подряд; помеченные элементы блока собираются в его
+// начале, поэтому пометка и разделение блока по пометкам выполняются за время,
+// пропорциональное числу помеченных элементов.
+class Partition {
+  private:
+	std::vector<int> elements;
+	// позиция элемента в elements
+	std::vector<int> location;
+	std::vector<int> block_of;
+	// блок i занимает [first[i], last[i]) в elements, помеченные - [first[i], mid[i])
+	std::vector<int> first;
+	std::vector<int> mid;
+	std::vector<int> last;
+	// блоки, в которых есть помеченные элементы
+	std::vector<int> touched;
+
+  public:
+	explicit Partition(int elements_number);
+
+	int size() const;
+	int block(int element) const;
+	int block_size(int block) const;
+	// элементы блока (порядок не определён)
+	const int* begin(int block) const;
+	const int* end(int block) const;
+
+	void mark(int element);
+	// каждый блок с помеченными и непомеченными элементами делится на два, помеченные элементы
+	// образуют новый блок; возвращает пары (разделённый блок, новый блок)
+	std::vector<std::pair<int, int>> split();
+};
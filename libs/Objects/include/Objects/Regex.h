@@ -12,6 +12,7 @@
 class FiniteAutomaton;
 class FAState;
 class BackRefRegex;
+class BitParallelMatcher;
 
 class Regex : public AlgExpression {
   private:
@@ -19,9 +20,6 @@ class Regex : public AlgExpression {
 	// возвращает указатель на new Regex
 	Regex* make() const override;
 
-	Regex* expr(const std::vector<Lexeme>&, int, int) override;
-	Regex* scan_minus(const std::vector<Lexeme>&, int, int);
-
 	bool equals(const AlgExpression* other) const override;
 
 	// Множество префиксов длины len
@@ -55,10 +53,15 @@ class Regex : public AlgExpression {
 	explicit Regex(const std::string&);
 	Regex(const std::string&, const std::shared_ptr<Language>&);
 	explicit Regex(Type type, AlgExpression* = nullptr, AlgExpression* = nullptr);
+	// term_l и term_r становятся поддеревьями без копирования
+	Regex(Type type, Regex&& term_l, Regex&& term_r);
+	Regex(Type type, Regex&& term_l);
 
 	Regex* make_copy() const override;
 	Regex(const Regex&) = default;
+	Regex(Regex&&) noexcept = default;
 	Regex& operator=(const Regex& other);
+	Regex& operator=(Regex&&) noexcept = default;
 
 	// dynamic_cast к типу Regex*
 	template <typename T> static Regex* cast(T* ptr, bool not_null_ptr = true);
@@ -71,6 +74,8 @@ class Regex : public AlgExpression {
 	FiniteAutomaton to_glushkov(iLogTemplate* log = nullptr) const;
 	FiniteAutomaton to_ilieyu(iLogTemplate* log = nullptr) const;
 	FiniteAutomaton to_antimirov(iLogTemplate* log = nullptr) const;
+	// битово-параллельный разборщик, построенный по позициям автомата Глушкова
+	BitParallelMatcher compile_bitparallel() const;
 	// проверка регулярок на равенство (пока работает только для стандартного построения)
 	static bool equal(const Regex&, const Regex&, iLogTemplate* log = nullptr);
 	// проверка регулярок на эквивалентность
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Symbol.h"
+
+class Language;
+class Regex;
+
+// Таблица хеш-консинга регулярных выражений: структурно равные подвыражения хранятся одной
+// неизменяемой нодой с уникальным номером, поэтому равенство выражений - сравнение
+// указателей, а номера нод годятся в ключи кэшей. Конструкторы нод сразу приводят выражение
+// к нормальной форме:
+//  - альтернатива ассоциативна, коммутативна и идемпотентна (ACI, как в rewrite_aci):
+//    альтернативы хранятся правой цепочкой без повторов, упорядоченной по номерам нод;
+//  - ∅ | r = r, а ε | r = r, если язык r содержит ε;
+//  - конкатенация правоассоциативна, ε·r = r·ε = r, ∅·r = r·∅ = ∅;
+//  - ∅* = ε* = ε, (r*)* = r*, ^^r = r.
+// Благодаря нормализации производные выражения образуют конечное множество нод.
+// Ноды живут, пока жива таблица
+class RegexDAG {
+  public:
+	enum class Type {
+		empty, // пустое множество
+		eps,
+		symb,
+		alt,
+		conc,
+		star,
+		negative,
+	};
+
+	struct Node {
+		Type type;
+		// номера выдаются подряд с 0 в порядке создания нод
+		int id;
+		Symbol symbol;
+		const Node* term_l;
+		const Node* term_r;
+		// язык ноды содержит пустое слово
+		bool nullable;
+	};
+
+  private:
+	struct NodeHasher {
+		std::size_t operator()(const Node*) const;
+	};
+	struct NodeEqual {
+		bool operator()(const Node*, const Node*) const;
+	};
+
+	std::deque<Node> nodes;
+	std::unordered_set<const Node*, NodeHasher, NodeEqual> index;
+	const Node* empty_node;
+	const Node* eps_node;
+	// производные по ключу (номер ноды << 32) | номер символа
+	std::unordered_map<uint64_t, const Node*> derivatives;
+
+	// возвращает ноду с такими полями, при необходимости добавляя её
+	const Node* intern(Type, const Symbol&, const Node* term_l, const Node* term_r);
+	// дописывает в alts альтернативы node
+	static void collect_alts(const Node* node,
+							 std::vector<const Node*>& alts); // NOLINT(runtime/references)
+	// дерево Regex без языка
+	Regex make_regex(const Node*) const;
+
+  public:
+	RegexDAG();
+	// ноды ссылаются друг на друга по адресам внутри таблицы
+	RegexDAG(const RegexDAG&) = delete;
+	RegexDAG& operator=(const RegexDAG&) = delete;
+
+	const Node* empty() const;
+	const Node* eps() const;
+	const Node* symb(const Symbol&);
+	const Node* alt(const Node*, const Node*);
+	const Node* alt(const std::vector<const Node*>&);
+	const Node* conc(const Node*, const Node*);
+	const Node* star(const Node*);
+	const Node* negative(const Node*);
+
+	// производная Бжозовского по символу; вычисляется один раз для пары (нода, символ)
+	const Node* derivative(const Node*, const Symbol&);
+
+	// символ Symbol::EmptySet переводится в пустое множество
+	const Node* from_regex(const Regex&);
+	// если language не задан, создаётся язык над алфавитом выражения
+	Regex to_regex(const Node*, std::shared_ptr<Language> language = nullptr) const;
+
+	// число нод в таблице
+	int size() const;
+};
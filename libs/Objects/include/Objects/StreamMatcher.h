@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "LazyDFA.h"
+
+class FiniteAutomaton;
+
+// Проверка принадлежности языку входа, поступающего частями (из канала, отображённого в память
+// файла и т.п.). Разбор идёт по ленивому ДКА, поэтому память ограничена размером его кэша и не
+// зависит от длины входа
+class StreamMatcher {
+  private:
+	LazyDFA dfa;
+	// текущее макросостояние ленивого ДКА
+	int macrostate;
+	int64_t position;
+	int64_t longest_accepted_prefix;
+
+  public:
+	explicit StreamMatcher(const FiniteAutomaton&, int cache_limit = LazyDFA::DefaultCacheLimit);
+
+	void feed(const char* data, size_t size);
+	// допускается ли весь прочитанный вход
+	bool is_accepting() const;
+	// длина прочитанного входа
+	int64_t get_position() const;
+	// длина наибольшего допускаемого префикса прочитанного входа, -1, если такого нет
+	int64_t get_longest_accepted_prefix() const;
+	// начало нового входа (кэш ленивого ДКА сохраняется)
+	void reset();
+};
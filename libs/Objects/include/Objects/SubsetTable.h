@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Хеш-таблица множеств состояний (подмножеств) с открытой адресацией.
+// Подмножество - отсортированный массив номеров состояний без повторов. Все подмножества
+// лежат подряд в одном массиве, каждое получает номер в порядке добавления.
+class SubsetTable {
+  public:
+	inline static const int NotFound = -1;
+
+	// отрезок массива элементов, занимаемый подмножеством
+	class Subset {
+	  private:
+		const int* first;
+		const int* last;
+
+	  public:
+		Subset(const int* first, const int* last);
+
+		const int* begin() const;
+		const int* end() const;
+		int size() const;
+	};
+
+  private:
+	std::vector<int> elements;
+	// подмножество i занимает [starts[i], starts[i + 1]) в elements
+	std::vector<int> starts = {0};
+	std::vector<size_t> hashes;
+	// номера подмножеств, NotFound - пустая ячейка; размер - степень двойки
+	std::vector<int> slots;
+
+	static size_t hash(const std::vector<int>&);
+	bool equal(int index, const std::vector<int>&) const;
+	// ячейка с подмножеством или пустая ячейка, в которую его следует поместить
+	size_t find_slot(const std::vector<int>&, size_t hash) const;
+	void grow();
+
+  public:
+	SubsetTable();
+
+	// номер подмножества или NotFound
+	int find(const std::vector<int>&) const;
+	// номер подмножества и true, если оно добавлено только что
+	std::pair<int, bool> insert(const std::vector<int>&);
+	Subset get(int index) const;
+	int size() const;
+	// удаляет все подмножества, сохраняя выделенную память
+	void clear();
+};
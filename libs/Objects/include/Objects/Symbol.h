@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <optional>
 #include <set>
@@ -7,16 +8,32 @@
 
 // Символ, по которому осуществляются переходы в автомате.
 // Может быть символом-буквой (и входить ТОЛЬКО в алфавит FA) или ссылкой (&i)
+// Все различные символы (буква, разметка, линеаризация, ссылка) хранятся в глобальной таблице
+// интернирования и получают 32-битный номер; сам Symbol - указатель на запись таблицы,
+// поэтому копирование, сравнение на равенство и хеширование не затрагивают строки.
+// Записи таблицы не освобождаются: её размер - число различных символов за время работы.
+// Ссылка &i создаётся только Symbol::Ref(i) и равна только другой ссылке на ту же ячейку:
+// символы, построенные из строк "i" и "&i", - не ссылки и ей не равны
 class Symbol {
   private:
-	std::vector<int> annote_numbers;
-	std::vector<int> linearize_numbers;
-	std::string symbol;
-	std::optional<int> reference;
-	// symbol + разметка
-	std::string value;
+	struct Data {
+		std::string symbol;
+		std::vector<int> annote_numbers;
+		std::vector<int> linearize_numbers;
+		std::optional<int> reference;
+		// symbol + разметка
+		std::string value;
+		uint32_t id;
+	};
+
+	// записи таблицы не удаляются и не перемещаются до завершения программы
+	const Data* data;
 
-	void update_value();
+	explicit Symbol(const Data* data);
+	// возвращает запись таблицы для набора полей, при необходимости добавляя её
+	static const Data* intern(std::string symbol, std::vector<int> annote_numbers,
+							  std::vector<int> linearize_numbers, std::optional<int> reference);
+	static const Data* intern(char c);
 
   public:
 	static const char linearize_marker = '.';
@@ -24,7 +41,7 @@ class Symbol {
 	inline static const std::string Epsilon = "eps";
 	inline static const std::string EmptySet = "-empty-";
 
-	Symbol() = default;
+	Symbol();
 	Symbol(const std::string& s); // NOLINT(runtime/explicit)
 	Symbol(const char* c);		  // NOLINT(runtime/explicit)
 	Symbol(char c);				  // NOLINT(runtime/explicit)
@@ -46,6 +63,8 @@ class Symbol {
 	bool operator!=(const Symbol& other) const;
 	bool operator<(const Symbol& other) const;
 
+	// номер символа в таблице интернирования
+	uint32_t get_id() const;
 	bool is_epsilon() const;
 	// преобразовывает вектор символов в одну строку
 	static std::string vector_to_str(const std::vector<Symbol>&);
@@ -1,6 +1,7 @@
 #pragma once
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -8,9 +9,11 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "FiniteAutomaton.h"
+#include "SubsetTable.h"
 #include "Symbol.h"
 #include "iLogTemplate.h"
 
@@ -37,46 +40,38 @@ class FA_model {
 	FiniteAutomaton make_fa();
 };
 
+// Моноид переходов автомата. Терм (класс эквивалентности слов) хранится как образ: для
+// каждого состояния q - номер множества состояний, достижимых из q по слову терма. Множества
+// интернированы в SubsetTable, одноэлементное множество {q} имеет номер q, поэтому у ДКА образ -
+// массив номеров состояний. Номера хранятся в 16 битах, пока множеств не больше 65536 (у НКА
+// их бывает больше - тогда все образы переводятся в 32 бита). Образы всех термов лежат подряд в
+// одном массиве и ищутся через
+// хеш-таблицу; новые термы получаются композицией образа терма с переходами по букве, а имя
+// терма задаётся его префиксом-родителем и последней буквой
 class TransformationMonoid {
   public:
-	// переход (индекс состояния - индекс состояния)
-	struct Transition {
-		int first;
-		int second;
-		bool operator==(const Transition& a) const {
-			return first == a.first && second == a.second;
-		}
-		bool operator>(const Transition& a) const {
-			return first > a.first && second > a.second;
-		}
-		bool operator<(const Transition& a) const {
-			return first < a.first || first == a.first && second < a.second;
-		}
-	};
-	// Терм (флаг оставляет ли в языке, имя, вектор переходов)
+	using Image = uint16_t;
+	using WideImage = uint32_t;
+	// Терм (флаг оставляет ли в языке, имя: терм-префикс и номер последней буквы алфавита)
 	struct Term {
 		bool isFinal = false;
-		std::vector<Symbol> name;
-		std::vector<Transition> transitions;
-		bool operator==(const Term& a) const {
-			return transitions == a.transitions;
-		}
-	};
-	// двойной терм (нужен для uwu переходов)
-	struct TermDouble {
-		Term first;
-		Term second;
+		// -1 у однобуквенных имён
+		int parent = -1;
+		int symbol = 0;
+		int length = 1;
 	};
 	TransformationMonoid() = default;
 	explicit TransformationMonoid(const FiniteAutomaton& in);
 	// получаем все классы эквивалентности
 	std::vector<Term> get_equalence_classes();
+	// имя терма (кратчайшее слово класса)
+	std::vector<Symbol> get_name(int term) const;
 	// получаем термы, что vw - в языке
-	std::vector<Term> get_equalence_classes_vw(const Term& w);
+	std::vector<int> get_equalence_classes_vw(int w);
 	// получаем термы, что wv - в языке
-	std::vector<Term> get_equalence_classes_wv(const Term& w);
-	// получаем термы, что vwv - в языке
-	std::vector<TermDouble> get_equalence_classes_vwv(const Term& w);
+	std::vector<int> get_equalence_classes_wv(int w);
+	// получаем пары термов, что v1wv2 - в языке
+	std::vector<std::pair<int, int>> get_equalence_classes_vwv(int w);
 	// получаем правила переписывания
 	std::map<std::vector<Symbol>, std::vector<std::vector<Symbol>>> get_rewriting_rules();
 	// вывод классов эквивалентных
@@ -88,7 +83,7 @@ class TransformationMonoid {
 	std::string to_txt();
 	// Вернет -1 если не синхронизирован или
 	// номер состояния с которым синхронизирован
-	int is_synchronized(const Term& w);
+	int is_synchronized(int w);
 	// Вернет число классов эквивалентности
 	int class_card(iLogTemplate* log = nullptr);
 	// Вернет длину самого длинного слова в классе
@@ -99,20 +94,32 @@ class TransformationMonoid {
 	int get_classes_number_MyhillNerode(iLogTemplate* log = nullptr);
 	// вывод таблицы М-Н
 	std::string to_txt_MyhillNerode();
-	//	переписываем имя терма в  минимальное
-	//	std::vector<Symbol> rewriting(
-	//		const std::vector<Symbol>&,
-	//		const std::map<std::vector<Symbol>, std::vector<std::vector<Symbol>>>&);
 	// возвращает таблицу М-Н
 	std::vector<std::vector<bool>> get_equivalence_classes_table(
 		std::vector<std::string>& table_rows,	  // NOLINT(runtime/references)
 		std::vector<std::string>& table_columns); // NOLINT(runtime/references)
 
   private:
+	// переход множества ещё не вычислен
+	inline static const int Unknown = -1;
+
 	// Автомат
 	FA_model automaton;
+	std::vector<Symbol> alphabet;
+	int states_number = 0;
 	// Классы эквивалентности
 	std::vector<Term> terms;
+	// образ терма t занимает [t * states_number, (t + 1) * states_number) в images, а если
+	// номера множеств не помещаются в Image (wide), - в wide_images
+	std::vector<Image> images;
+	std::vector<WideImage> wide_images;
+	bool wide = false;
+	// множества состояний, встречающиеся в образах, и наличие в них финальных состояний
+	SubsetTable subsets;
+	std::vector<char> final_subsets;
+	// переход множества subset по букве symbol: subset_transitions[subset * alphabet.size() +
+	// symbol]
+	std::vector<int> subset_transitions;
 	// Правила переписывания
 	std::map<std::vector<Symbol>, std::vector<std::vector<Symbol>>> rules;
 	// Taблица М-Н
@@ -128,18 +135,21 @@ class TransformationMonoid {
 	// f | 0 bool0
 	// t | 1 0 1 1
 
-	// очередь на проверку термов (в ней лежат непроверенные кандидаты)
-	std::queue<Term> queueTerm;
 	// флаг (неминимальны ли ловушки)
 	bool trap_not_minimal = false;
-	// проверяем имя терма на  переписываемость (вспомогательный)
-	static bool was_rewrite(const std::vector<Symbol>&, const std::vector<Symbol>&);
-	// проверка на присутствие терма
-	static bool was_transition(const std::set<TransformationMonoid::Transition>&,
-							   const TransformationMonoid::Transition&);
-	// проверяем имя терма на переписываемость
-	bool searchrewrite(const std::vector<Symbol>&);
-	// генерируем новые переходы по алфавиту
-	void get_new_transition(const std::vector<TransformationMonoid::Transition>&,
-							const std::vector<Symbol>&, const std::set<Symbol>&);
+	// имя терма в номерах букв alphabet
+	std::vector<int> get_word(int term) const;
+	// номер множества, в которое терм term переводит состояние state
+	int get_image(int term, int state) const;
+	// дописывает номер множества в конец images
+	void push_image(int subset);
+	// удаляет образ последнего терма
+	void pop_image();
+	// номер множества, в которое переходит subset по букве symbol
+	int get_next_subset(int subset, int symbol);
+	// добавляет множество состояний, возвращает его номер
+	int add_subset(const std::vector<int>&);
+	// число финальных состояний, достижимых из начального по словам термов sequence
+	// (последовательно) - столько пар (начальное, финальное) в отношении их конкатенации
+	int count_final_pairs(const std::vector<int>& sequence) const;
 };
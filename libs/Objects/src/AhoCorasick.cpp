@@ -0,0 +1,101 @@
+#include <stdexcept>
+#include <utility>
+
+#include "Objects/AhoCorasick.h"
+
+using std::vector;
+
+int AhoCorasick::Level::patterns_number() const {
+	return static_cast<int>(starts.size()) - 1;
+}
+
+AhoCorasick::AhoCorasick(int symbols_number) : symbols_number(symbols_number) {}
+
+void AhoCorasick::build(Level& level) const {
+	level.transitions.assign(symbols_number, -1);
+	level.terminal.assign(1, false);
+	for (int pattern = 0; pattern < level.patterns_number(); pattern++) {
+		int node = 0;
+		for (int i = level.starts[pattern]; i < level.starts[pattern + 1]; i++) {
+			int edge = node * symbols_number + level.symbols[i];
+			if (level.transitions[edge] == -1) {
+				level.transitions[edge] = static_cast<int>(level.terminal.size());
+				level.transitions.resize(level.transitions.size() + symbols_number, -1);
+				level.terminal.push_back(false);
+			}
+			node = level.transitions[edge];
+		}
+		level.terminal[node] = true;
+	}
+
+	// обход в ширину: ссылка узла ведёт в более мелкий узел, все переходы которого уже
+	// известны, поэтому недостающие переходы узла берутся у узла по ссылке
+	vector<int> links(level.terminal.size(), 0);
+	vector<int> order;
+	for (int symbol = 0; symbol < symbols_number; symbol++) {
+		int& next = level.transitions[symbol];
+		if (next == -1)
+			next = 0;
+		else
+			order.push_back(next);
+	}
+	for (size_t head = 0; head < order.size(); head++) {
+		int node = order[head];
+		if (level.terminal[links[node]])
+			level.terminal[node] = true;
+		for (int symbol = 0; symbol < symbols_number; symbol++) {
+			int& next = level.transitions[node * symbols_number + symbol];
+			int by_link = level.transitions[links[node] * symbols_number + symbol];
+			if (next == -1) {
+				next = by_link;
+			} else {
+				links[next] = by_link;
+				order.push_back(next);
+			}
+		}
+	}
+}
+
+void AhoCorasick::add(const vector<int>& pattern) {
+	for (int symbol : pattern)
+		if (symbol < 0 || symbol >= symbols_number)
+			throw std::invalid_argument("AhoCorasick: symbol is out of the alphabet");
+	Level carry;
+	carry.symbols = pattern;
+	carry.starts.push_back(static_cast<int>(pattern.size()));
+	// сливаем с заполненными уровнями, как при прибавлении единицы к двоичному числу
+	int level = 0;
+	for (; level < levels.size() && levels[level].patterns_number() > 0; level++) {
+		Level& merged = levels[level];
+		int offset = static_cast<int>(carry.symbols.size());
+		carry.symbols.insert(carry.symbols.end(), merged.symbols.begin(), merged.symbols.end());
+		for (int i = 1; i < merged.starts.size(); i++)
+			carry.starts.push_back(merged.starts[i] + offset);
+		merged = Level();
+	}
+	if (level == levels.size())
+		levels.emplace_back();
+	build(carry);
+	levels[level] = std::move(carry);
+	patterns_number++;
+}
+
+bool AhoCorasick::contains_match(const vector<int>& text) const {
+	for (const auto& level : levels) {
+		if (level.patterns_number() == 0)
+			continue;
+		int node = 0;
+		if (level.terminal[node])
+			return true;
+		for (int symbol : text) {
+			node = level.transitions[node * symbols_number + symbol];
+			if (level.terminal[node])
+				return true;
+		}
+	}
+	return false;
+}
+
+int AhoCorasick::size() const {
+	return patterns_number;
+}
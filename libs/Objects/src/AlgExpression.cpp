@@ -70,6 +70,34 @@ AlgExpression::AlgExpression(const AlgExpression& other) : AlgExpression() {
 		term_r = other.term_r->make_copy();
 }
 
+AlgExpression::AlgExpression(AlgExpression&& other) noexcept
+	: BaseObject(std::move(other.language)), alphabet(std::move(other.alphabet)), type(other.type),
+	  symbol(other.symbol), term_l(other.term_l), term_r(other.term_r) {
+	other.type = Type::eps;
+	other.term_l = nullptr;
+	other.term_r = nullptr;
+}
+
+AlgExpression& AlgExpression::operator=(AlgExpression&& other) noexcept {
+	if (this == &other)
+		return *this;
+	// other может быть поддеревом this, поэтому старые поддеревья удаляются последними
+	AlgExpression* old_term_l = term_l;
+	AlgExpression* old_term_r = term_r;
+	language = std::move(other.language);
+	alphabet = std::move(other.alphabet);
+	type = other.type;
+	symbol = other.symbol;
+	term_l = other.term_l;
+	term_r = other.term_r;
+	other.type = Type::eps;
+	other.term_l = nullptr;
+	other.term_r = nullptr;
+	delete old_term_l;
+	delete old_term_r;
+	return *this;
+}
+
 Symbol AlgExpression::get_symbol() const {
 	return symbol;
 }
@@ -486,7 +514,7 @@ bool AlgExpression::from_string(const string& str, bool allow_ref, bool allow_ne
 	}
 
 	vector<Lexeme> l = parse_string(str, allow_ref, allow_negation);
-	AlgExpression* root = expr(l, 0, l.size());
+	AlgExpression* root = parse_lexemes(l);
 
 	if (root == nullptr || root->type == eps) {
 		delete root;
@@ -500,136 +528,144 @@ bool AlgExpression::from_string(const string& str, bool allow_ref, bool allow_ne
 	return true;
 }
 
-void AlgExpression::update_balance(const AlgExpression::Lexeme& l, int& balance) {
-	if (l.type == Lexeme::Type::parL || l.type == Lexeme::Type::squareBrL) {
-		balance++;
-	}
-	if (l.type == Lexeme::Type::parR || l.type == Lexeme::Type::squareBrR) {
-		balance--;
+AlgExpression* AlgExpression::parse_lexemes(const vector<AlgExpression::Lexeme>& lexemes) {
+	size_t pos = 0;
+	AlgExpression* root = parse_alt(lexemes, pos);
+	if (root && pos != lexemes.size()) {
+		delete root;
+		return nullptr;
 	}
+	return root;
 }
 
-AlgExpression* AlgExpression::scan_conc(const vector<AlgExpression::Lexeme>& lexemes,
-										int index_start, int index_end) {
-	AlgExpression* p = nullptr;
-	int balance = 0;
-	for (int i = index_start; i < index_end; i++) {
-		update_balance(lexemes[i], balance);
-		if (lexemes[i].type == Lexeme::Type::conc && balance == 0) {
-			AlgExpression* l = expr(lexemes, index_start, i);
-			AlgExpression* r = expr(lexemes, i + 1, index_end);
-			if (l == nullptr || r == nullptr || r->type == Type::eps ||
-				l->type == Type::eps) { // Проверка на адекватность)
-				delete r;
-				delete l;
-				return p;
-			}
-
-			p = make();
-			p->term_l = l;
-			p->term_r = r;
-			p->symbol = lexemes[i].symbol;
-			p->type = Type::conc;
-
-			p->alphabet = l->alphabet;
-			p->alphabet.insert(r->alphabet.begin(), r->alphabet.end());
-			return p;
-		}
+AlgExpression* AlgExpression::join_terms(vector<AlgExpression*>& terms, Type type) const {
+	// операции правоассоциативны: w1 w2 w3 = w1 (w2 w3)
+	AlgExpression* p = terms.back();
+	for (int i = static_cast<int>(terms.size()) - 2; i >= 0; i--) {
+		AlgExpression* node = make();
+		node->type = type;
+		node->term_l = terms[i];
+		node->term_r = p;
+		node->alphabet = terms[i]->alphabet;
+		node->alphabet.insert(p->alphabet.begin(), p->alphabet.end());
+		p = node;
 	}
-	return nullptr;
+	return p;
 }
 
-AlgExpression* AlgExpression::scan_star(const vector<AlgExpression::Lexeme>& lexemes,
-										int index_start, int index_end) {
-	AlgExpression* p = nullptr;
-	int balance = 0;
-	for (int i = index_start; i < index_end; i++) {
-		update_balance(lexemes[i], balance);
-		if (lexemes[i].type == Lexeme::Type::star && balance == 0) {
-			AlgExpression* l = expr(lexemes, index_start, i);
-			if (l == nullptr || l->type == Type::eps) {
-				delete l;
-				return p;
-			}
-
-			p = make();
-			p->term_l = l;
-			p->type = Type::star;
-
-			p->alphabet = l->alphabet;
-			return p;
+AlgExpression* AlgExpression::parse_alt(const vector<AlgExpression::Lexeme>& lexemes,
+										size_t& pos) {
+	vector<AlgExpression*> terms;
+	while (true) {
+		AlgExpression* term = parse_conc(lexemes, pos);
+		if (term == nullptr) {
+			for (auto& i : terms)
+				delete i;
+			return nullptr;
 		}
+		terms.push_back(term);
+		if (pos >= lexemes.size() || lexemes[pos].type != Lexeme::Type::alt)
+			break;
+		pos++;
 	}
-	return nullptr;
+	return join_terms(terms, Type::alt);
 }
 
-AlgExpression* AlgExpression::scan_alt(const vector<AlgExpression::Lexeme>& lexemes,
-									   int index_start, int index_end) {
-	AlgExpression* p = nullptr;
-	int balance = 0;
-	for (int i = index_start; i < index_end; i++) {
-		update_balance(lexemes[i], balance);
-		if (lexemes[i].type == Lexeme::Type::alt && balance == 0) {
-			AlgExpression* l = expr(lexemes, index_start, i);
-			AlgExpression* r = expr(lexemes, i + 1, index_end);
-			if (l == nullptr || r == nullptr) { // Проверка на адекватность)
-				delete r;
-				delete l;
-				return nullptr;
-			}
-
-			p = make();
-			p->term_l = l;
-			p->term_r = r;
-			p->type = Type::alt;
-
-			p->alphabet = l->alphabet;
-			p->alphabet.insert(r->alphabet.begin(), r->alphabet.end());
-			return p;
-		}
+AlgExpression* AlgExpression::parse_conc(const vector<AlgExpression::Lexeme>& lexemes,
+										 size_t& pos) {
+	vector<AlgExpression*> terms;
+	while (true) {
+		AlgExpression* term = parse_star(lexemes, pos);
+		terms.push_back(term);
+		if (term == nullptr || pos >= lexemes.size() || lexemes[pos].type != Lexeme::Type::conc)
+			break;
+		pos++;
 	}
-	return nullptr;
+	// пустое слово не может быть операндом конкатенации
+	bool correct = terms.back() != nullptr;
+	if (terms.size() > 1)
+		for (auto& i : terms)
+			correct &= i != nullptr && i->type != Type::eps;
+	if (!correct) {
+		for (auto& i : terms)
+			delete i;
+		return nullptr;
+	}
+	return join_terms(terms, Type::conc);
 }
 
-AlgExpression* AlgExpression::scan_symb(const vector<AlgExpression::Lexeme>& lexemes,
-										int index_start, int index_end) {
-	AlgExpression* p = nullptr;
-	if (index_start >= lexemes.size() || (index_end - index_start > 1) ||
-		lexemes[index_start].type != Lexeme::Type::symb) {
+AlgExpression* AlgExpression::parse_star(const vector<AlgExpression::Lexeme>& lexemes,
+										 size_t& pos) {
+	// итерация применяется после отрицания: ^a* = (^a)*
+	AlgExpression* l = parse_negative(lexemes, pos);
+	if (l == nullptr || pos >= lexemes.size() || lexemes[pos].type != Lexeme::Type::star)
+		return l;
+	pos++;
+	if (l->type == Type::eps) {
+		delete l;
 		return nullptr;
 	}
 
-	p = make();
-	p->symbol = lexemes[index_start].symbol;
-	p->type = Type::symb;
-	p->alphabet = {lexemes[index_start].symbol};
+	AlgExpression* p = make();
+	p->term_l = l;
+	p->type = Type::star;
+	p->alphabet = l->alphabet;
 	return p;
 }
 
-AlgExpression* AlgExpression::scan_eps(const vector<AlgExpression::Lexeme>& lexemes,
-									   int index_start, int index_end) {
-	AlgExpression* p = nullptr;
-	if (index_start >= lexemes.size() || (index_end - index_start != 1) ||
-		lexemes[index_start].type != Lexeme::Type::eps) {
+AlgExpression* AlgExpression::parse_negative(const vector<AlgExpression::Lexeme>& lexemes,
+											 size_t& pos) {
+	if (pos >= lexemes.size() || lexemes[pos].type != Lexeme::Type::negative)
+		return parse_atom(lexemes, pos);
+	pos++;
+	AlgExpression* l = parse_negative(lexemes, pos);
+	if (l == nullptr)
 		return nullptr;
-	}
 
-	p = make();
-	p->symbol = Symbol::Epsilon;
-	p->type = Type::eps;
+	AlgExpression* p = make();
+	p->term_l = l;
+	p->type = Type::negative;
+	p->alphabet = l->alphabet;
 	return p;
 }
 
-AlgExpression* AlgExpression::scan_par(const vector<AlgExpression::Lexeme>& lexemes,
-									   int index_start, int index_end) {
-	AlgExpression* p = nullptr;
-	if ((index_end - 1) >= lexemes.size() || (lexemes[index_start].type != Lexeme::Type::parL ||
-											  lexemes[index_end - 1].type != Lexeme::Type::parR)) {
+AlgExpression* AlgExpression::parse_atom(const vector<AlgExpression::Lexeme>& lexemes,
+										 size_t& pos) {
+	if (pos >= lexemes.size())
 		return nullptr;
+	AlgExpression* p = nullptr;
+	switch (lexemes[pos].type) {
+	case Lexeme::Type::symb:
+		p = make();
+		p->symbol = lexemes[pos].symbol;
+		p->type = Type::symb;
+		p->alphabet = {lexemes[pos].symbol};
+		pos++;
+		return p;
+	case Lexeme::Type::eps:
+		p = make();
+		p->symbol = Symbol::Epsilon;
+		p->type = Type::eps;
+		pos++;
+		return p;
+	case Lexeme::Type::parL:
+		pos++;
+		p = parse_alt(lexemes, pos);
+		if (p == nullptr)
+			return nullptr;
+		if (pos >= lexemes.size() || lexemes[pos].type != Lexeme::Type::parR) {
+			delete p;
+			return nullptr;
+		}
+		pos++;
+		return p;
+	default:
+		return parse_memory(lexemes, pos);
 	}
+}
 
-	p = expr(lexemes, index_start + 1, index_end - 1);
-	return p;
+AlgExpression* AlgExpression::parse_memory(const vector<AlgExpression::Lexeme>&, size_t&) {
+	return nullptr;
 }
 
 // bool AlgExpression::equality_checker(const AlgExpression* expr1, const AlgExpression* expr2) {
@@ -177,61 +177,37 @@ string BackRefRegex::type_to_str() const {
 	return {};
 }
 
-BackRefRegex* BackRefRegex::expr(const vector<AlgExpression::Lexeme>& lexemes, int index_start,
-								 int index_end) {
-	AlgExpression* p;
-	p = scan_alt(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_conc(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_star(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_symb(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_ref(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_eps(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_par(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_square_br(lexemes, index_start, index_end);
-	return cast(p, false);
-}
-
-BackRefRegex* BackRefRegex::scan_ref(const vector<AlgExpression::Lexeme>& lexemes, int index_start,
-									 int index_end) {
-	BackRefRegex* p = nullptr;
-	if (index_start >= lexemes.size() || (index_end - index_start > 1) ||
-		lexemes[index_start].type != Lexeme::Type::ref) {
+BackRefRegex* BackRefRegex::parse_memory(const vector<AlgExpression::Lexeme>& lexemes,
+										 size_t& pos) {
+	if (pos >= lexemes.size())
 		return nullptr;
-	}
-
-	p = new BackRefRegex();
-	p->symbol = lexemes[index_start].symbol;
-	p->type = AlgExpression::ref;
-	p->cell_number = lexemes[index_start].number;
-	return p;
-}
-
-BackRefRegex* BackRefRegex::scan_square_br(const vector<AlgExpression::Lexeme>& lexemes,
-										   int index_start, int index_end) {
 	BackRefRegex* p = nullptr;
-	if ((index_end - 1) >= lexemes.size() ||
-		(lexemes[index_start].type != Lexeme::Type::squareBrL ||
-		 lexemes[index_end - 1].type != Lexeme::Type::squareBrR)) {
-		return nullptr;
+	const Lexeme& lexeme = lexemes[pos];
+	if (lexeme.type == Lexeme::Type::ref) {
+		p = new BackRefRegex();
+		p->symbol = lexeme.symbol;
+		p->type = AlgExpression::ref;
+		p->cell_number = lexeme.number;
+		pos++;
+		return p;
 	}
+	if (lexeme.type != Lexeme::Type::squareBrL)
+		return nullptr;
 
-	BackRefRegex* l = expr(lexemes, index_start + 1, index_end - 1);
-	if (l == nullptr) {
+	pos++;
+	BackRefRegex* l = cast(parse_alt(lexemes, pos), false);
+	if (l == nullptr)
+		return nullptr;
+	if (pos >= lexemes.size() || lexemes[pos].type != Lexeme::Type::squareBrR) {
 		delete l;
-		return p;
+		return nullptr;
 	}
+	pos++;
 
 	p = new BackRefRegex();
 	p->term_l = l;
 	p->type = AlgExpression::memoryWriter;
-	p->cell_number = lexemes[index_start].number;
+	p->cell_number = lexeme.number;
 	p->alphabet = l->alphabet;
 	return p;
 }
@@ -0,0 +1,102 @@
+#include <algorithm>
+
+#include "Objects/BitParallelMatcher.h"
+
+using std::string;
+using std::vector;
+
+namespace {
+const int MaskBits = 64;
+const int ChunkBits = 8;
+const int ChunkValues = 256;
+} // namespace
+
+BitParallelMatcher::BitParallelMatcher(const vector<vector<int>>& follow,
+									   const vector<string>& symbols,
+									   const vector<int>& final_positions)
+	: positions_number(static_cast<int>(follow.size())),
+	  words_number((positions_number + MaskBits - 1) / MaskBits),
+	  chunks_number((positions_number + ChunkBits - 1) / ChunkBits),
+	  symbol_masks(ChunkValues * words_number), final_mask(words_number) {
+	auto set_bit = [](Mask* mask, int position) {
+		mask[position / MaskBits] |= Mask(1) << (position % MaskBits);
+	};
+	for (int position = 1; position < positions_number; position++)
+		if (symbols[position].size() == 1)
+			set_bit(symbol_masks.data() +
+						static_cast<unsigned char>(symbols[position][0]) * words_number,
+					position);
+	for (int position : final_positions)
+		set_bit(final_mask.data(), position);
+
+	// маски Follow отдельных позиций, затем таблицы для байтов
+	vector<Mask> position_follow(positions_number * words_number);
+	for (int position = 0; position < positions_number; position++)
+		for (int to : follow[position])
+			set_bit(position_follow.data() + position * words_number, to);
+	follow_table.resize(static_cast<size_t>(chunks_number) * ChunkValues * words_number);
+	for (int chunk = 0; chunk < chunks_number; chunk++)
+		for (int value = 1; value < ChunkValues; value++) {
+			// value = (value без старшего бита) | старший бит
+			int high_bit = ChunkBits - 1;
+			while (!(value >> high_bit & 1))
+				high_bit--;
+			int position = chunk * ChunkBits + high_bit;
+			Mask* mask = follow_table.data() + (chunk * ChunkValues + value) * words_number;
+			const Mask* rest = follow_table.data() +
+							   (chunk * ChunkValues + (value ^ (1 << high_bit))) * words_number;
+			for (int i = 0; i < words_number; i++) {
+				mask[i] = rest[i];
+				if (position < positions_number)
+					mask[i] |= position_follow[position * words_number + i];
+			}
+		}
+}
+
+int BitParallelMatcher::size() const {
+	return positions_number;
+}
+
+bool BitParallelMatcher::parse(const string& s) const {
+	if (words_number == 1) {
+		// до 64 позиций маска помещается в одно машинное слово
+		Mask active = 1;
+		for (char c : s) {
+			Mask next = 0;
+			for (int chunk = 0; chunk < chunks_number; chunk++)
+				next |= follow_table[chunk * ChunkValues + (active >> (chunk * ChunkBits) & 0xff)];
+			active = next & symbol_masks[static_cast<unsigned char>(c)];
+			if (!active)
+				return false;
+		}
+		return active & final_mask[0];
+	}
+
+	vector<Mask> active(words_number), next(words_number);
+	active[0] = 1;
+	for (char c : s) {
+		std::fill(next.begin(), next.end(), 0);
+		for (int chunk = 0; chunk < chunks_number; chunk++) {
+			int value =
+				active[chunk * ChunkBits / MaskBits] >> (chunk * ChunkBits % MaskBits) & 0xff;
+			if (!value)
+				continue;
+			const Mask* mask = follow_table.data() + (chunk * ChunkValues + value) * words_number;
+			for (int i = 0; i < words_number; i++)
+				next[i] |= mask[i];
+		}
+		const Mask* symbol_mask =
+			symbol_masks.data() + static_cast<unsigned char>(c) * words_number;
+		bool is_empty = true;
+		for (int i = 0; i < words_number; i++) {
+			active[i] = next[i] & symbol_mask[i];
+			is_empty &= !active[i];
+		}
+		if (is_empty)
+			return false;
+	}
+	for (int i = 0; i < words_number; i++)
+		if (active[i] & final_mask[i])
+			return true;
+	return false;
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <bitset>
+#include <memory>
+
+#include "Objects/BitsetSimulator.h"
+#include "Objects/EpsilonClosures.h"
+#include "Objects/FiniteAutomaton.h"
+#include "Objects/FrozenAutomaton.h"
+
+using std::pair;
+using std::string;
+using std::vector;
+
+namespace {
+const int MaskBits = 64;
+
+int popcount(BitsetSimulator::Mask word) {
+	return static_cast<int>(std::bitset<MaskBits>(word).count());
+}
+
+// номер младшего единичного бита (последовательность де Брёйна)
+int lowest_bit(BitsetSimulator::Mask word) {
+	static const int positions[MaskBits] = {
+		0,	1,	48, 2,	57, 49, 28, 3,	61, 58, 50, 42, 38, 29, 17, 4,	62, 55, 59, 36, 53, 51,
+		43, 22, 45, 39, 33, 30, 24, 18, 12, 5,	63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21,
+		44, 32, 23, 11, 46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9,	13, 8,	7,	6};
+	const BitsetSimulator::Mask debruijn = 0x03f79d71b4cb0a89ULL;
+	return positions[((word & (~word + 1)) * debruijn) >> 58];
+}
+} // namespace
+
+BitsetSimulator::BitsetSimulator(const FiniteAutomaton& fa) {
+	FrozenAutomaton frozen = fa.freeze();
+	std::shared_ptr<const EpsilonClosures> closures = fa.get_epsilon_closures();
+	states_number = frozen.size();
+	symbols_number = frozen.symbols_number();
+	words_number = (states_number + MaskBits - 1) / MaskBits;
+	initial.resize(words_number);
+	terminal.resize(words_number);
+	has_transitions.resize(static_cast<size_t>(symbols_number) * words_number);
+	mask_ids.assign(static_cast<size_t>(symbols_number) * states_number, NoMask);
+	for (int c = 0; c < 256; c++)
+		char_ids[c] = frozen.get_char_id(static_cast<char>(c));
+	if (states_number > 0)
+		for (int state : closures->get(frozen.get_initial()))
+			initial[state / MaskBits] |= Mask(1) << (state % MaskBits);
+	for (int state = 0; state < states_number; state++) {
+		if (frozen.is_terminal(state))
+			terminal[state / MaskBits] |= Mask(1) << (state % MaskBits);
+		for (int symbol_id = 0; symbol_id < symbols_number; symbol_id++) {
+			FrozenAutomaton::Targets targets = frozen.get_transitions(state, symbol_id);
+			if (symbol_id == frozen.get_epsilon_id() || targets.empty())
+				continue;
+			has_transitions[static_cast<size_t>(symbol_id) * words_number + state / MaskBits] |=
+				Mask(1) << (state % MaskBits);
+			int mask_id = static_cast<int>(successors.size() / words_number);
+			mask_ids[static_cast<size_t>(symbol_id) * states_number + state] = mask_id;
+			successors.resize(successors.size() + words_number);
+			Mask* mask = successors.data() + static_cast<size_t>(mask_id) * words_number;
+			for (int to : targets)
+				for (int closure_state : closures->get(to))
+					mask[closure_state / MaskBits] |= Mask(1) << (closure_state % MaskBits);
+		}
+	}
+}
+
+pair<int, bool> BitsetSimulator::parse(const string& s) const {
+	int counter = 0;
+	vector<Mask> current(initial), next(words_number);
+	for (char c : s) {
+		for (Mask word : current)
+			counter += popcount(word);
+		int symbol_id = char_ids[static_cast<unsigned char>(c)];
+		if (symbol_id == FrozenAutomaton::NoSymbol)
+			return {counter, false};
+		std::fill(next.begin(), next.end(), 0);
+		const Mask* with_transitions =
+			has_transitions.data() + static_cast<size_t>(symbol_id) * words_number;
+		const int* symbol_mask_ids =
+			mask_ids.data() + static_cast<size_t>(symbol_id) * states_number;
+		for (int i = 0; i < words_number; i++)
+			for (Mask word = current[i] & with_transitions[i]; word; word &= word - 1) {
+				int state = i * MaskBits + lowest_bit(word);
+				const Mask* mask =
+					successors.data() + static_cast<size_t>(symbol_mask_ids[state]) * words_number;
+				for (int j = 0; j < words_number; j++)
+					next[j] |= mask[j];
+			}
+		current.swap(next);
+		// пустое множество нельзя продолжить до допускающего
+		if (std::all_of(current.begin(), current.end(), [](Mask word) { return word == 0; }))
+			return {counter, false};
+	}
+	for (Mask word : current)
+		counter += popcount(word);
+	for (int i = 0; i < words_number; i++)
+		if (current[i] & terminal[i])
+			return {counter, true};
+	return {counter, false};
+}
@@ -0,0 +1,66 @@
+#include "Objects/BrzozowskiDFA.h"
+#include "Objects/Language.h"
+#include "Objects/Regex.h"
+
+using std::string;
+
+BrzozowskiDFA::BrzozowskiDFA(const Regex& regex) {
+	char_ids.fill(-1);
+	for (const Symbol& symbol : regex.get_language()->get_alphabet()) {
+		string value = symbol;
+		if (value.size() != 1)
+			continue;
+		char_ids[static_cast<unsigned char>(value[0])] = symbols.size();
+		symbols.push_back(symbol);
+	}
+	add_state(dag.from_regex(regex));
+	dead_state = add_state(dag.empty());
+}
+
+int BrzozowskiDFA::add_state(const RegexDAG::Node* node) {
+	if (node->id >= state_index.size())
+		state_index.resize(node->id + 1, -1);
+	int& index = state_index[node->id];
+	if (index == -1) {
+		index = states.size();
+		states.push_back(node);
+		transitions.resize(transitions.size() + symbols.size(), Unknown);
+	}
+	return index;
+}
+
+int BrzozowskiDFA::get_initial() const {
+	return 0;
+}
+
+int BrzozowskiDFA::next(int state, char c) {
+	int symbol_id = char_ids[static_cast<unsigned char>(c)];
+	if (symbol_id == -1)
+		return dead_state;
+	size_t position = static_cast<size_t>(state) * symbols.size() + symbol_id;
+	if (transitions[position] == Unknown)
+		transitions[position] = add_state(dag.derivative(states[state], symbols[symbol_id]));
+	return transitions[position];
+}
+
+bool BrzozowskiDFA::is_accepting(int state) const {
+	return states[state]->nullable;
+}
+
+bool BrzozowskiDFA::is_dead(int state) const {
+	return state == dead_state;
+}
+
+bool BrzozowskiDFA::parse(const string& word) {
+	int state = get_initial();
+	for (char c : word) {
+		state = next(state, c);
+		if (is_dead(state))
+			return false;
+	}
+	return is_accepting(state);
+}
+
+int BrzozowskiDFA::states_number() const {
+	return states.size();
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <utility>
+
+#include "Objects/EpsilonClosures.h"
+#include "Objects/FiniteAutomaton.h"
+
+using std::pair;
+using std::vector;
+
+EpsilonClosures::EpsilonClosures(const FiniteAutomaton& fa) : epsilon_offsets(1, 0) {
+	for (const auto& state : fa.states) {
+		auto by_eps = state.transitions.find(Symbol::Epsilon);
+		if (by_eps != state.transitions.end())
+			epsilon_targets.insert(
+				epsilon_targets.end(), by_eps->second.begin(), by_eps->second.end());
+		epsilon_offsets.push_back(static_cast<int>(epsilon_targets.size()));
+	}
+	build();
+}
+
+EpsilonClosures::EpsilonClosures(const FrozenAutomaton& frozen) : epsilon_offsets(1, 0) {
+	for (int state = 0; state < frozen.size(); state++) {
+		if (frozen.get_epsilon_id() != FrozenAutomaton::NoSymbol)
+			for (int to : frozen.get_transitions(state, frozen.get_epsilon_id()))
+				epsilon_targets.push_back(to);
+		epsilon_offsets.push_back(static_cast<int>(epsilon_targets.size()));
+	}
+	build();
+}
+
+void EpsilonClosures::build() {
+	int states_number = size();
+	components.assign(states_number, -1);
+	// нерекурсивный алгоритм Тарьяна: order - номер состояния в порядке обхода,
+	// low - наименьший номер, достижимый из поддерева через состояния стека компонент
+	vector<int> order(states_number, -1), low(states_number);
+	vector<int> component_stack;
+	// (состояние, позиция следующего eps-перехода)
+	vector<pair<int, int>> dfs_stack;
+	vector<int> visited(states_number, -1);
+	int counter = 0;
+	auto enter = [&](int state) {
+		order[state] = low[state] = counter++;
+		component_stack.push_back(state);
+		dfs_stack.emplace_back(state, epsilon_offsets[state]);
+	};
+	for (int root = 0; root < states_number; root++) {
+		if (order[root] != -1)
+			continue;
+		enter(root);
+		while (!dfs_stack.empty()) {
+			auto [state, edge] = dfs_stack.back();
+			if (edge < epsilon_offsets[state + 1]) {
+				dfs_stack.back().second++;
+				int to = epsilon_targets[edge];
+				if (order[to] == -1)
+					enter(to);
+				else if (components[to] == -1)
+					low[state] = std::min(low[state], order[to]);
+				continue;
+			}
+			dfs_stack.pop_back();
+			if (!dfs_stack.empty()) {
+				int parent = dfs_stack.back().first;
+				low[parent] = std::min(low[parent], low[state]);
+			}
+			if (low[state] != order[state])
+				continue;
+
+			// state - корень компоненты: её состояния сверху стека
+			int component = static_cast<int>(closures.size());
+			vector<int> closure;
+			int member;
+			do {
+				member = component_stack.back();
+				component_stack.pop_back();
+				components[member] = component;
+				visited[member] = component;
+				closure.push_back(member);
+			} while (member != state);
+			int members_number = static_cast<int>(closure.size());
+			for (int i = 0; i < members_number; i++)
+				for (int edge = epsilon_offsets[closure[i]]; edge < epsilon_offsets[closure[i] + 1];
+					 edge++) {
+					int to_component = components[epsilon_targets[edge]];
+					if (to_component == component)
+						continue;
+					for (int closure_state : closures[to_component])
+						if (visited[closure_state] != component) {
+							visited[closure_state] = component;
+							closure.push_back(closure_state);
+						}
+				}
+			std::sort(closure.begin(), closure.end());
+			closures.push_back(std::move(closure));
+		}
+	}
+}
+
+int EpsilonClosures::size() const {
+	return static_cast<int>(epsilon_offsets.size()) - 1;
+}
+
+const vector<int>& EpsilonClosures::get(int state) const {
+	return closures[components[state]];
+}
+
+int EpsilonClosures::get_component(int state) const {
+	return components[state];
+}
+
+int EpsilonClosures::components_number() const {
+	return static_cast<int>(closures.size());
+}
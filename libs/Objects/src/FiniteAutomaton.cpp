@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cmath>
+#include <memory>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -10,12 +11,17 @@
 #include <utility>
 
 #include "Fraction/Fraction.h"
-#include "Fraction/InfInt.h"
+#include "Fraction/BigInt.h"
+#include "Objects/BacktrackingParser.h"
+#include "Objects/EpsilonClosures.h"
 #include "Objects/FiniteAutomaton.h"
+#include "Objects/FlatDFA.h"
 #include "Objects/Grammar.h"
 #include "Objects/Language.h"
 #include "Objects/MemoryFiniteAutomaton.h"
 #include "Objects/MetaInfo.h"
+#include "Objects/Partition.h"
+#include "Objects/SubsetTable.h"
 #include "Objects/iLogTemplate.h"
 
 using std::cerr;
@@ -70,6 +76,138 @@ string FAState::to_txt() const {
 	return {};
 }
 
+FAStates::FAStates(vector<FAState> states) : states(std::move(states)) {}
+
+FAStates::FAStates(const FAStates& other) : states(other.states) {}
+
+FAStates::FAStates(FAStates&& other) noexcept : states(std::move(other.states)) {
+	other.states.clear();
+}
+
+FAStates& FAStates::operator=(const FAStates& other) {
+	if (this != &other) {
+		invalidate();
+		states = other.states;
+	}
+	return *this;
+}
+
+FAStates& FAStates::operator=(FAStates&& other) noexcept {
+	if (this != &other) {
+		invalidate();
+		states = std::move(other.states);
+		other.states.clear();
+	}
+	return *this;
+}
+
+FAStates& FAStates::operator=(vector<FAState> other) {
+	invalidate();
+	states = std::move(other);
+	return *this;
+}
+
+void FAStates::invalidate() {
+	// неконстантный доступ не пересекается с другими обращениями, поэтому проверка индекса
+	// может быть неатомарной
+	if (epsilon_closures)
+		std::atomic_store(&epsilon_closures, std::shared_ptr<const EpsilonClosures>());
+}
+
+FAStates::operator const vector<FAState>&() const {
+	return states;
+}
+
+size_t FAStates::size() const {
+	return states.size();
+}
+
+bool FAStates::empty() const {
+	return states.empty();
+}
+
+const FAState& FAStates::operator[](size_t index) const {
+	return states[index];
+}
+
+const FAState& FAStates::back() const {
+	return states.back();
+}
+
+vector<FAState>::const_iterator FAStates::begin() const {
+	return states.begin();
+}
+
+vector<FAState>::const_iterator FAStates::end() const {
+	return states.end();
+}
+
+FAState& FAStates::operator[](size_t index) {
+	invalidate();
+	return states[index];
+}
+
+FAState& FAStates::back() {
+	invalidate();
+	return states.back();
+}
+
+vector<FAState>::iterator FAStates::begin() {
+	invalidate();
+	return states.begin();
+}
+
+vector<FAState>::iterator FAStates::end() {
+	invalidate();
+	return states.end();
+}
+
+void FAStates::push_back(FAState state) {
+	invalidate();
+	states.push_back(std::move(state));
+}
+
+void FAStates::pop_back() {
+	invalidate();
+	states.pop_back();
+}
+
+void FAStates::resize(size_t size) {
+	invalidate();
+	states.resize(size);
+}
+
+void FAStates::reserve(size_t size) {
+	states.reserve(size);
+}
+
+void FAStates::clear() {
+	invalidate();
+	states.clear();
+}
+
+vector<FAState>::iterator FAStates::erase(vector<FAState>::const_iterator position) {
+	invalidate();
+	return states.erase(position);
+}
+
+vector<FAState>::iterator FAStates::erase(vector<FAState>::const_iterator first,
+										  vector<FAState>::const_iterator last) {
+	invalidate();
+	return states.erase(first, last);
+}
+
+std::shared_ptr<const EpsilonClosures> FAStates::get_epsilon_closures(
+	const FiniteAutomaton& fa) const {
+	std::shared_ptr<const EpsilonClosures> closures = std::atomic_load(&epsilon_closures);
+	if (!closures) {
+		// несколько потоков могут построить индекс одновременно, сохранится один из равных
+		closures = std::make_shared<const EpsilonClosures>(fa);
+		std::atomic_store(&epsilon_closures, closures);
+	}
+	return closures;
+}
+
 FiniteAutomaton::FiniteAutomaton() : AbstractMachine() {}
 
 FiniteAutomaton::FiniteAutomaton(int initial_state, vector<FAState> states,
@@ -130,6 +268,14 @@ vector<FAState> FiniteAutomaton::get_states() const {
 	return states;
 }
 
+FrozenAutomaton FiniteAutomaton::freeze() const {
+	return FrozenAutomaton(*this);
+}
+
+std::shared_ptr<const EpsilonClosures> FiniteAutomaton::get_epsilon_closures() const {
+	return states.get_epsilon_closures(*this);
+}
+
 // обход автомата в глубину
 void FiniteAutomaton::dfs(int index,
 						  set<int>& reachable, // NOLINT(runtime/references)
@@ -163,96 +309,84 @@ FiniteAutomaton FiniteAutomaton::determinize(bool is_trim, iLogTemplate* log) co
 		if (log)
 			log->set_parameter("trap", " (с добавлением ловушки)");
 	FiniteAutomaton dfa = FiniteAutomaton(0, {}, language);
-	set<int> q0 = closure({initial_state}, true);
+	FrozenAutomaton frozen = freeze();
+	int alphabet_size = frozen.get_alphabet_size();
+	std::shared_ptr<const EpsilonClosures> eps_closures = get_epsilon_closures();
 	MetaInfo old_meta, new_meta;
-	set<int> label = q0;
-	string new_identifier;
 	int group_counter = 0;
-	for (auto elem : label) {
-		new_identifier += (new_identifier.empty() || states[elem].identifier.empty() ? "" : ", ") +
-						  states[elem].identifier;
-	}
-	FAState new_initial_state = {0, label, new_identifier, false, FAState::Transitions()};
-	dfa.states.push_back(new_initial_state);
 
-	if (q0.size() > 1) {
-		for (auto elem : q0) {
+	// подмножества состояний НКА; номер подмножества совпадает с номером состояния ДКА
+	SubsetTable subsets;
+	auto add_state = [&](const vector<int>& subset) {
+		string new_identifier;
+		bool is_terminal = false;
+		for (int elem : subset) {
+			new_identifier +=
+				(new_identifier.empty() || states[elem].identifier.empty() ? "" : ", ") +
+				states[elem].identifier;
+			is_terminal |= states[elem].is_terminal;
+		}
+		dfa.states.emplace_back(dfa.size(),
+								set<int>(subset.begin(), subset.end()),
+								new_identifier,
+								is_terminal,
+								FAState::Transitions());
+	};
+
+	const vector<int>& q0 = eps_closures->get(initial_state);
+	subsets.insert(q0);
+	add_state(q0);
+	if (log && q0.size() > 1) {
+		set<int> label(q0.begin(), q0.end());
+		for (auto elem : label) {
 			old_meta.upd(NodeMeta{states[elem].index, group_counter});
 		}
-		old_meta.mark_transitions(*this, q0, q0, Symbol::Epsilon, group_counter);
-		new_meta.upd(NodeMeta{new_initial_state.index, group_counter});
+		old_meta.mark_transitions(*this, label, label, Symbol::Epsilon, group_counter);
+		new_meta.upd(NodeMeta{0, group_counter});
 		group_counter++;
 	}
 
-	std::stack<set<int>> s1;
-	std::stack<int> s2;
-	s1.push(q0);
-	s2.push(0);
-
-	while (!s1.empty()) {
-		set<int> z = s1.top();
-		int index = s2.top();
-		s1.pop();
-		s2.pop();
-		FAState q = dfa.states[index];
-
-		for (int i : z) {
-			if (states[i].is_terminal) {
-				dfa.states[index].is_terminal = true;
-				break;
-			}
-		}
-
-		set<int> new_x;
-		for (const Symbol& symb : language->get_alphabet()) {
-			new_x.clear();
-			for (int j : z) {
-				auto transitions_by_symbol = states[j].transitions.find(symb);
-				if (transitions_by_symbol != states[j].transitions.end())
-					for (int k : transitions_by_symbol->second) {
-						new_x.insert(k);
-					}
-			}
-
-			set<int> z1 = closure(new_x, true);
-			new_identifier = "";
-			for (auto elem : z1) {
-				new_identifier +=
-					(new_identifier.empty() || states[elem].identifier.empty() ? "" : ", ") +
-					states[elem].identifier;
-			}
-
-			FAState q1 = {-1, z1, new_identifier, false, FAState::Transitions()};
-			bool accessory_flag = false;
-
-			for (const auto& state : dfa.states) {
-				if (q1.label == state.label) {
-					index = state.index;
-					accessory_flag = true;
-					break;
-				}
-			}
-
-			if (!accessory_flag)
-				index = -1;
-			if (index != -1) {
-				q1 = dfa.states[index];
-			} else {
-				index = dfa.size();
-				q1.index = index;
-				dfa.states.push_back(q1);
-				s1.push(z1);
-				s2.push(index);
-				if (z1.size() > 1) {
+	// порядок обхода (стек, символы в порядке алфавита) определяет нумерацию состояний ДКА
+	vector<int> s = {0};
+	vector<vector<int>> successors(alphabet_size);
+	while (!s.empty()) {
+		int index = s.back();
+		s.pop_back();
+
+		// переходы по всем символам собираются за один проход по подмножеству
+		for (auto& successor : successors)
+			successor.clear();
+		for (int j : subsets.get(index))
+			for (int symb_id = 0; symb_id < alphabet_size; symb_id++)
+				for (int k : frozen.get_transitions(j, symb_id))
+					successors[symb_id].insert(successors[symb_id].end(),
+											   eps_closures->get(k).begin(),
+											   eps_closures->get(k).end());
+
+		for (int symb_id = 0; symb_id < alphabet_size; symb_id++) {
+			vector<int>& z1 = successors[symb_id];
+			std::sort(z1.begin(), z1.end());
+			z1.erase(std::unique(z1.begin(), z1.end()), z1.end());
+			const Symbol& symb = frozen.get_symbol(symb_id);
+
+			auto [to_index, is_new] = subsets.insert(z1);
+			if (is_new) {
+				add_state(z1);
+				s.push_back(to_index);
+				if (log && z1.size() > 1) {
 					for (auto elem : z1) {
 						old_meta.upd(NodeMeta{states[elem].index, group_counter});
 					}
-					old_meta.mark_transitions(*this, z, z1, symb, group_counter);
-					new_meta.upd(NodeMeta{q1.index, group_counter});
+					old_meta.mark_transitions(*this,
+											  dfa.states[index].label,
+											  dfa.states[to_index].label,
+											  symb,
+											  group_counter);
+					new_meta.upd(NodeMeta{to_index, group_counter});
 					group_counter++;
 				}
 			}
-			dfa.states[q.index].transitions[symb].insert(q1.index);
+			dfa.states[index].transitions[symb].insert(to_index);
 		}
 	}
 	if (log) {
@@ -287,12 +421,54 @@ FiniteAutomaton FiniteAutomaton::minimize(bool is_trim, iLogTemplate* log) const
 	}
 	// минимизация
 	FiniteAutomaton dfa = determinize();
-	vector<bool> table(dfa.size() * dfa.size());
+	// для лога используется алгоритм заполнения таблицы, классы совпадают
+	vector<int> classes = log ? dfa.get_table_filling_classes() : dfa.get_hopcroft_classes();
+	auto [minimized_dfa, class_to_index] = dfa.merge_classes(classes);
+
+	// кэширование
+	language->set_min_dfa(minimized_dfa);
+
+	// удаление ловушки по желанию пользователя
+	if (is_trim)
+		minimized_dfa = minimized_dfa.remove_trap_states();
+
+	stringstream ss;
+	for (const auto& state : minimized_dfa.states) {
+		ss << "\\{" << state.identifier << "\\};";
+	}
+	MetaInfo old_meta, new_meta;
+	vector<int> class_sizes(dfa.size());
+	for (int i = 0; i < dfa.size(); i++)
+		class_sizes[classes[i]]++;
+	for (int i = 0; i < dfa.size(); i++) {
+		if (class_sizes[classes[i]] > 1) {
+			old_meta.upd(NodeMeta{dfa.states[i].index, classes[i]});
+			new_meta.upd(NodeMeta{class_to_index.at(classes[i]), classes[i]});
+		}
+	}
+
+	if (log) {
+		if (!is_deterministic()) {
+			log->set_parameter("oldautomaton", *this);
+			log->set_parameter("to_determ", "Автомат после предварительной детерминизации: ");
+			log->set_parameter("detautomaton", dfa, old_meta);
+		} else {
+			log->set_parameter("oldautomaton", dfa, old_meta);
+		}
+		log->set_parameter("equivclasses", ss.str());
+		log->set_parameter("result", minimized_dfa, new_meta);
+	}
+	return minimized_dfa;
+}
+
+vector<int> FiniteAutomaton::get_table_filling_classes() const {
+	FrozenAutomaton frozen_dfa = freeze();
+	vector<bool> table(size() * size());
 	int counter = 1;
-	for (int i = 1; i < dfa.size(); i++) {
+	for (int i = 1; i < size(); i++) {
 		for (int j = 0; j < counter; j++) {
-			if (dfa.states[i].is_terminal ^ dfa.states[j].is_terminal) {
-				table[i * dfa.size() + j] = true;
+			if (states[i].is_terminal ^ states[j].is_terminal) {
+				table[i * size() + j] = true;
 			}
 		}
 		counter++;
@@ -302,19 +478,16 @@ FiniteAutomaton FiniteAutomaton::minimize(bool is_trim, iLogTemplate* log) const
 	while (flag) {
 		counter = 1;
 		flag = false;
-		for (int i = 1; i < dfa.size(); i++) {
+		for (int i = 1; i < size(); i++) {
 			for (int j = 0; j < counter; j++) {
-				if (!table[i * dfa.size() + j]) {
-					for (const Symbol& symb : language->get_alphabet()) {
-						vector<int> to = {*dfa.states[i].transitions.at(symb).begin(),
-										  *dfa.states[j].transitions.at(symb).begin()};
-						if (*dfa.states[i].transitions.at(symb).begin() <
-							*dfa.states[j].transitions.at(symb).begin()) {
-							to = {*dfa.states[j].transitions.at(symb).begin(),
-								  *dfa.states[i].transitions.at(symb).begin()};
-						}
-						if (table[to[0] * dfa.size() + to[1]]) {
-							table[i * dfa.size() + j] = true;
+				if (!table[i * size() + j]) {
+					for (int symb_id = 0; symb_id < frozen_dfa.get_alphabet_size(); symb_id++) {
+						int to_i = frozen_dfa.get_transitions(i, symb_id).front();
+						int to_j = frozen_dfa.get_transitions(j, symb_id).front();
+						if (to_i < to_j)
+							std::swap(to_i, to_j);
+						if (table[to_i * size() + to_j]) {
+							table[i * size() + j] = true;
 							flag = true;
 						}
 					}
@@ -327,9 +500,9 @@ FiniteAutomaton FiniteAutomaton::minimize(bool is_trim, iLogTemplate* log) const
 	set<int> visited;
 	vector<vector<int>> groups;
 	counter = 1;
-	for (int i = 1; i < dfa.size(); i++) {
+	for (int i = 1; i < size(); i++) {
 		for (int j = 0; j < counter; j++) {
-			if (!table[i * dfa.size() + j]) {
+			if (!table[i * size() + j]) {
 				groups.push_back({i, j});
 				visited.insert(i);
 				visited.insert(j);
@@ -371,53 +544,97 @@ FiniteAutomaton FiniteAutomaton::minimize(bool is_trim, iLogTemplate* log) const
 		counter++;
 	}
 
-	for (int i = 0; i < dfa.size(); i++) {
-		if (visited.find(dfa.states[i].index) == visited.end()) {
-			groups.push_back({dfa.states[i].index});
+	for (int i = 0; i < size(); i++) {
+		if (visited.find(states[i].index) == visited.end()) {
+			groups.push_back({states[i].index});
 		}
 	}
 
-	vector<int> classes(dfa.size());
+	vector<int> classes(size());
 	for (int i = 0; i < groups.size(); i++) {
 		for (int j = 0; j < groups[i].size(); j++) {
 			classes[groups[i][j]] = i;
 		}
 	}
-	auto [minimized_dfa, class_to_index] = dfa.merge_classes(classes);
-
-	// кэширование
-	language->set_min_dfa(minimized_dfa);
-
-	// удаление ловушки по желанию пользователя
-	if (is_trim)
-		minimized_dfa = minimized_dfa.remove_trap_states();
-
-	stringstream ss;
-	for (const auto& state : minimized_dfa.states) {
-		ss << "\\{" << state.identifier << "\\};";
-	}
-	MetaInfo old_meta, new_meta;
-	for (int i = 0; i < dfa.size(); i++) {
-		for (int j = 0; j < dfa.size(); j++)
-			if (classes[i] == classes[j] && (i != j)) {
-				old_meta.upd(NodeMeta{dfa.states[i].index, classes[i]});
-				new_meta.upd(NodeMeta{class_to_index.at(classes[i]), classes[i]});
-				break;
-			}
-	}
+	return classes;
+}
 
-	if (log) {
-		if (!is_deterministic()) {
-			log->set_parameter("oldautomaton", *this);
-			log->set_parameter("to_determ", "Автомат после предварительной детерминизации: ");
-			log->set_parameter("detautomaton", dfa, old_meta);
-		} else {
-			log->set_parameter("oldautomaton", dfa, old_meta);
-		}
-		log->set_parameter("equivclasses", ss.str());
-		log->set_parameter("result", minimized_dfa, new_meta);
-	}
-	return minimized_dfa;
+vector<int> FiniteAutomaton::get_hopcroft_classes() const {
+	FrozenAutomaton frozen_dfa = freeze();
+	int states_number = frozen_dfa.size();
+	int alphabet_size = frozen_dfa.get_alphabet_size();
+
+	// обратные переходы в формате CSR: строка to * alphabet_size + symb_id содержит
+	// состояния, из которых по символу symb_id есть переход в to
+	auto row = [alphabet_size, &frozen_dfa](int from, int symb_id) {
+		return static_cast<size_t>(frozen_dfa.get_transitions(from, symb_id).front()) *
+				   alphabet_size +
+			   symb_id;
+	};
+	vector<int> inverse_offsets(static_cast<size_t>(states_number) * alphabet_size + 1, 0);
+	for (int from = 0; from < states_number; from++)
+		for (int symb_id = 0; symb_id < alphabet_size; symb_id++)
+			inverse_offsets[row(from, symb_id) + 1]++;
+	for (size_t i = 1; i < inverse_offsets.size(); i++)
+		inverse_offsets[i] += inverse_offsets[i - 1];
+	vector<int> inverse(inverse_offsets.back());
+	vector<int> positions(inverse_offsets.begin(), inverse_offsets.end() - 1);
+	for (int from = 0; from < states_number; from++)
+		for (int symb_id = 0; symb_id < alphabet_size; symb_id++)
+			inverse[positions[row(from, symb_id)]++] = from;
+
+	Partition partition(states_number);
+	for (int i = 0; i < states_number; i++)
+		if (frozen_dfa.is_terminal(i))
+			partition.mark(i);
+	partition.split();
+
+	// блоки-разделители, которые ещё предстоит обработать
+	vector<int> splitters;
+	vector<char> in_splitters(partition.size(), true);
+	for (int b = 0; b < partition.size(); b++)
+		splitters.push_back(b);
+	vector<int> splitter_states;
+	while (!splitters.empty()) {
+		int splitter = splitters.back();
+		splitters.pop_back();
+		in_splitters[splitter] = false;
+		// блок может разделиться, пока обрабатываются символы
+		splitter_states.assign(partition.begin(splitter), partition.end(splitter));
+		for (int symb_id = 0; symb_id < alphabet_size; symb_id++) {
+			for (int to : splitter_states) {
+				size_t to_row = static_cast<size_t>(to) * alphabet_size + symb_id;
+				for (int i = inverse_offsets[to_row]; i < inverse_offsets[to_row + 1]; i++)
+					partition.mark(inverse[i]);
+			}
+			for (auto [old_block, new_block] : partition.split()) {
+				// в очереди достаточно одной из половин блока, если самого блока в ней нет
+				in_splitters.push_back(false);
+				int added = new_block;
+				if (!in_splitters[old_block] &&
+					partition.block_size(old_block) < partition.block_size(new_block))
+					added = old_block;
+				splitters.push_back(added);
+				in_splitters[added] = true;
+			}
+		}
+	}
+
+	// нумерация классов как в get_table_filling_classes
+	vector<int> block_class(partition.size(), -1);
+	vector<int> seen(partition.size(), 0);
+	int classes_number = 0;
+	for (int i = 0; i < states_number; i++)
+		if (++seen[partition.block(i)] == 2)
+			block_class[partition.block(i)] = classes_number++;
+	for (int i = 0; i < states_number; i++)
+		if (block_class[partition.block(i)] == -1)
+			block_class[partition.block(i)] = classes_number++;
+
+	vector<int> classes(states_number);
+	for (int i = 0; i < states_number; i++)
+		classes[i] = block_class[partition.block(i)];
+	return classes;
 }
 
 FiniteAutomaton FiniteAutomaton::remove_eps(iLogTemplate* log) const {
@@ -438,7 +655,12 @@ FiniteAutomaton FiniteAutomaton::remove_eps(iLogTemplate* log) const {
 	map<set<int>, int> visited_states;
 	MetaInfo old_meta, new_meta;
 	int group_counter = 0;
-	set<int> initial_closure = closure({initial_state}, true);
+	std::shared_ptr<const EpsilonClosures> eps_closures = get_epsilon_closures();
+	auto eps_closure = [&](int state) {
+		const vector<int>& state_closure = eps_closures->get(state);
+		return set<int>(state_closure.begin(), state_closure.end());
+	};
+	set<int> initial_closure = eps_closure(initial_state);
 
 	if (initial_closure.size() > 1) {
 		for (auto elem : initial_closure) {
@@ -469,7 +691,7 @@ FiniteAutomaton FiniteAutomaton::remove_eps(iLogTemplate* log) const {
 				}
 			}
 			for (int k : transitions_to) {
-				set<int> cur_closure = closure({k}, true);
+				set<int> cur_closure = eps_closure(k);
 				if (!cur_closure.empty()) {
 					if (visited_states.find(cur_closure) == visited_states.end()) {
 						FAState new_state(states_counter,
@@ -521,27 +743,24 @@ FiniteAutomaton FiniteAutomaton::remove_eps_additional(iLogTemplate* log) const
 	for (auto& state : new_nfa.states)
 		state.transitions = FAState::Transitions();
 
+	std::shared_ptr<const EpsilonClosures> eps_closures = get_epsilon_closures();
 	for (int i = 0; i < states.size(); i++) {
-		set<int> q = closure({states[i].index}, true);
+		const vector<int>& q = eps_closures->get(states[i].index);
 		for (int elem : q) {
 			if (states[elem].is_terminal) {
 				new_nfa.states[i].is_terminal = true;
 			}
 		}
-		vector<set<int>> x;
 		for (const Symbol& symb : language->get_alphabet()) {
-			x.clear();
+			// объединение eps-замыканий состояний, достижимых из q по symb
+			set<int> x1;
 			for (int k : q) {
 				auto transitions_by_symbol = states[k].transitions.find(symb);
-				if (transitions_by_symbol != states[k].transitions.end())
-					x.push_back(transitions_by_symbol->second);
-			}
-			set<int> q1;
-			set<int> x1;
-			for (const auto& k : x) {
-				q1 = closure(k, true);
-				for (int m : q1) {
-					x1.insert(m);
+				if (transitions_by_symbol == states[k].transitions.end())
+					continue;
+				for (int to : transitions_by_symbol->second) {
+					const vector<int>& to_closure = eps_closures->get(to);
+					x1.insert(to_closure.begin(), to_closure.end());
 				}
 			}
 			for (auto elem : x1) {
@@ -557,8 +776,9 @@ FiniteAutomaton FiniteAutomaton::remove_eps_additional(iLogTemplate* log) const
 	return new_nfa;
 }
 
-FiniteAutomaton FiniteAutomaton::intersection(const FiniteAutomaton& fa1,
-											  const FiniteAutomaton& fa2, iLogTemplate* log) {
+FiniteAutomaton FiniteAutomaton::get_product(const FiniteAutomaton& fa1,
+											 const FiniteAutomaton& fa2,
+											 ProductOperation operation) {
 	Alphabet merged_alphabets = fa1.language->get_alphabet();
 	for (const auto& symb : fa2.language->get_alphabet()) {
 		merged_alphabets.insert(symb);
@@ -567,32 +787,77 @@ FiniteAutomaton FiniteAutomaton::intersection(const FiniteAutomaton& fa1,
 	FiniteAutomaton new_dfa2(fa2.initial_state, fa2.states, merged_alphabets);
 	new_dfa1 = new_dfa1.determinize();
 	new_dfa2 = new_dfa2.determinize();
-	FiniteAutomaton new_dfa(0, {}, merged_alphabets);
-	int counter = 0;
-	vector<pair<int, int>> state_pair; // пары индексов состояний
-	for (const auto& state1 : new_dfa1.states) {
-		for (const auto& state2 : new_dfa2.states) {
-			string new_identifier;
-			new_identifier = state1.identifier.empty() ? "" : state1.identifier;
-			new_identifier += (state2.identifier.empty() ? "" : ", " + state2.identifier);
-			new_dfa.states.push_back({counter,
-									  {state1.index, state2.index},
-									  new_identifier,
-									  state1.is_terminal && state2.is_terminal,
-									  FAState::Transitions()});
-			state_pair.emplace_back(state1.index, state2.index);
-			counter++;
+	// алфавиты снимков совпадают, поэтому номера символов в них одинаковы
+	FrozenAutomaton frozen_dfa1 = new_dfa1.freeze();
+	FrozenAutomaton frozen_dfa2 = new_dfa2.freeze();
+	int alphabet_size = frozen_dfa1.get_alphabet_size();
+
+	// обход пар состояний, достижимых из пары начальных; пара (state1, state2) хранится
+	// по ключу state1 * |Q2| + state2, переходы пар - в порядке их обнаружения
+	vector<pair<int, int>> state_pairs;
+	unordered_map<long long, int> pair_indices;
+	vector<int> pair_transitions;
+	auto add_pair = [&](int state1, int state2) {
+		auto [it, inserted] = pair_indices.emplace(
+			static_cast<long long>(state1) * new_dfa2.size() + state2, state_pairs.size());
+		if (inserted)
+			state_pairs.emplace_back(state1, state2);
+		return it->second;
+	};
+	add_pair(new_dfa1.initial_state, new_dfa2.initial_state);
+	for (int i = 0; i < state_pairs.size(); i++) {
+		auto [state1, state2] = state_pairs[i];
+		for (int symb_id = 0; symb_id < alphabet_size; symb_id++)
+			pair_transitions.push_back(
+				add_pair(frozen_dfa1.get_transitions(state1, symb_id).front(),
+						 frozen_dfa2.get_transitions(state2, symb_id).front()));
+	}
+
+	// состояния произведения нумеруются по возрастанию ключа пары, как если бы были построены
+	// все |Q1| * |Q2| пар, а затем удалены недостижимые
+	vector<int> order(state_pairs.size());
+	for (int i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&](int i, int j) {
+		return state_pairs[i] < state_pairs[j];
+	});
+	vector<int> new_indices(state_pairs.size());
+	for (int i = 0; i < order.size(); i++)
+		new_indices[order[i]] = i;
+
+	string separator = operation == ProductOperation::product_union ? " | " : ", ";
+	vector<FAState> new_states;
+	for (int i = 0; i < order.size(); i++) {
+		auto [state1, state2] = state_pairs[order[i]];
+		const FAState& dfa1_state = new_dfa1.states[state1];
+		const FAState& dfa2_state = new_dfa2.states[state2];
+		string new_identifier = dfa1_state.identifier;
+		new_identifier += (dfa2_state.identifier.empty() ? "" : separator + dfa2_state.identifier);
+		bool is_terminal;
+		switch (operation) {
+		case ProductOperation::product_intersection:
+			is_terminal = dfa1_state.is_terminal && dfa2_state.is_terminal;
+			break;
+		case ProductOperation::product_union:
+			is_terminal = dfa1_state.is_terminal || dfa2_state.is_terminal;
+			break;
+		case ProductOperation::product_difference:
+			is_terminal = dfa1_state.is_terminal && !dfa2_state.is_terminal;
+			break;
 		}
+		FAState::Transitions transitions;
+		for (int symb_id = 0; symb_id < alphabet_size; symb_id++)
+			transitions[frozen_dfa1.get_symbol(symb_id)].insert(
+				new_indices[pair_transitions[order[i] * alphabet_size + symb_id]]);
+		new_states.push_back(
+			{i, {state1, state2}, new_identifier, is_terminal, std::move(transitions)});
 	}
+	return {new_indices[0], std::move(new_states), merged_alphabets};
+}
 
-	for (int i = 0; i < new_dfa.size(); i++) {
-		for (const Symbol& symb : new_dfa.language->get_alphabet()) {
-			new_dfa.states[i].transitions[symb].insert(
-				*new_dfa1.states[state_pair[i].first].transitions.at(symb).begin() *
-					new_dfa2.size() +
-				*new_dfa2.states[state_pair[i].second].transitions.at(symb).begin());
-		}
-	}
+FiniteAutomaton FiniteAutomaton::intersection(const FiniteAutomaton& fa1,
+											  const FiniteAutomaton& fa2, iLogTemplate* log) {
+	FiniteAutomaton new_dfa = get_product(fa1, fa2, ProductOperation::product_intersection);
 	Alphabet new_alphabet;
 	set_intersection(fa1.language->get_alphabet().begin(),
 					 fa1.language->get_alphabet().end(),
@@ -600,17 +865,6 @@ FiniteAutomaton FiniteAutomaton::intersection(const FiniteAutomaton& fa1,
 					 fa2.language->get_alphabet().end(),
 					 inserter(new_alphabet, new_alphabet.begin()));
 	new_dfa.language->set_alphabet(new_alphabet);
-	for (int i = 0; i < new_dfa.size(); i++) {
-		FAState::Transitions new_transitions;
-		for (const Symbol& symb : merged_alphabets) {
-			if (auto transition = new_dfa.states[i].transitions.find(symb);
-				transition != new_dfa.states[i].transitions.end()) {
-				new_transitions[symb] = transition->second;
-			}
-		}
-		new_dfa.states[i].transitions = new_transitions;
-	}
-	new_dfa = new_dfa.remove_unreachable_states();
 	if (log) {
 		log->set_parameter("automaton1", fa1);
 		log->set_parameter("automaton2", fa2);
@@ -621,41 +875,7 @@ FiniteAutomaton FiniteAutomaton::intersection(const FiniteAutomaton& fa1,
 
 FiniteAutomaton FiniteAutomaton::uunion(const FiniteAutomaton& fa1, const FiniteAutomaton& fa2,
 										iLogTemplate* log) {
-	Alphabet merged_alphabets = fa1.language->get_alphabet();
-	for (const auto& symb : fa2.language->get_alphabet()) {
-		merged_alphabets.insert(symb);
-	}
-	FiniteAutomaton new_dfa1(fa1.initial_state, fa1.states, merged_alphabets);
-	FiniteAutomaton new_dfa2(fa2.initial_state, fa2.states, merged_alphabets);
-	new_dfa1 = new_dfa1.determinize();
-	new_dfa2 = new_dfa2.determinize();
-	FiniteAutomaton new_dfa(0, {}, merged_alphabets);
-	int counter = 0;
-	vector<pair<int, int>> state_pair; // пары индексов состояний
-	for (const auto& state1 : new_dfa1.states) {
-		for (const auto& state2 : new_dfa2.states) {
-			string new_identifier;
-			new_identifier = state1.identifier.empty() ? "" : state1.identifier;
-			new_identifier += (state2.identifier.empty() ? "" : " | " + state2.identifier);
-			new_dfa.states.push_back({counter,
-									  {state1.index, state2.index},
-									  new_identifier,
-									  state1.is_terminal || state2.is_terminal,
-									  FAState::Transitions()});
-			state_pair.emplace_back(state1.index, state2.index);
-			counter++;
-		}
-	}
-
-	for (int i = 0; i < new_dfa.size(); i++) {
-		for (const Symbol& symb : new_dfa.language->get_alphabet()) {
-			new_dfa.states[i].transitions[symb].insert(
-				*new_dfa1.states[state_pair[i].first].transitions.at(symb).begin() *
-					new_dfa2.size() +
-				*new_dfa2.states[state_pair[i].second].transitions.at(symb).begin());
-		}
-	}
-	new_dfa = new_dfa.remove_unreachable_states();
+	FiniteAutomaton new_dfa = get_product(fa1, fa2, ProductOperation::product_union);
 	if (log) {
 		log->set_parameter("automaton1", fa1);
 		log->set_parameter("automaton2", fa2);
@@ -666,52 +886,8 @@ FiniteAutomaton FiniteAutomaton::uunion(const FiniteAutomaton& fa1, const Finite
 
 FiniteAutomaton FiniteAutomaton::difference(const FiniteAutomaton& fa1, const FiniteAutomaton& fa2,
 											iLogTemplate* log) {
-	Alphabet merged_alphabets = fa1.language->get_alphabet();
-	for (const auto& symb : fa2.language->get_alphabet()) {
-		merged_alphabets.insert(symb);
-	}
-	FiniteAutomaton new_dfa1(fa1.initial_state, fa1.states, merged_alphabets);
-	FiniteAutomaton new_dfa2(fa2.initial_state, fa2.states, merged_alphabets);
-	new_dfa1 = new_dfa1.determinize();
-	new_dfa2 = new_dfa2.determinize();
-	FiniteAutomaton new_dfa(0, {}, merged_alphabets);
-	int counter = 0;
-	vector<pair<int, int>> state_pair; // пары индексов состояний
-	for (const auto& state1 : new_dfa1.states) {
-		for (const auto& state2 : new_dfa2.states) {
-			string new_identifier;
-			new_identifier = state1.identifier.empty() ? "" : state1.identifier;
-			new_identifier += (state2.identifier.empty() ? "" : ", " + state2.identifier);
-			new_dfa.states.push_back({counter,
-									  {state1.index, state2.index},
-									  new_identifier,
-									  state1.is_terminal && !state2.is_terminal,
-									  FAState::Transitions()});
-			state_pair.emplace_back(state1.index, state2.index);
-			counter++;
-		}
-	}
-
-	for (int i = 0; i < new_dfa.size(); i++) {
-		for (const Symbol& symb : new_dfa.language->get_alphabet()) {
-			new_dfa.states[i].transitions[symb].insert(
-				*new_dfa1.states[state_pair[i].first].transitions.at(symb).begin() *
-					new_dfa2.size() +
-				*new_dfa2.states[state_pair[i].second].transitions.at(symb).begin());
-		}
-	}
+	FiniteAutomaton new_dfa = get_product(fa1, fa2, ProductOperation::product_difference);
 	new_dfa.language->set_alphabet(fa1.language->get_alphabet());
-	for (int i = 0; i < new_dfa.size(); i++) {
-		FAState::Transitions new_transitions;
-		for (const Symbol& symb : merged_alphabets) {
-			if (auto transition = new_dfa.states[i].transitions.find(symb);
-				transition != new_dfa.states[i].transitions.end()) {
-				new_transitions[symb] = transition->second;
-			}
-		}
-		new_dfa.states[i].transitions = new_transitions;
-	}
-	new_dfa = new_dfa.remove_unreachable_states();
 	if (log) {
 		log->set_parameter("automaton1", fa1);
 		log->set_parameter("automaton2", fa2);
@@ -900,56 +1076,35 @@ FiniteAutomaton FiniteAutomaton::remove_trap_states(iLogTemplate* log) const {
 }
 
 FiniteAutomaton FiniteAutomaton::remove_unreachable_states() const {
-	if (states.size() == 1)
+	if (states.size() <= 1)
 		return *this;
-	FiniteAutomaton new_dfa(initial_state, states, language);
-	int count = new_dfa.size();
-	for (int i = 0; i >= 0 && i < count; i++) {
-		bool is_unreachable_state = false;
-		set<int> reachable_states = new_dfa.closure({new_dfa.initial_state}, false);
-		if (reachable_states.find(i) == reachable_states.end()) {
-			is_unreachable_state = true;
-		}
-		if (is_unreachable_state) {
-			vector<FAState> new_states;
-			for (int j = 0; j < new_dfa.size(); j++) {
-				if (j < i) {
-					new_states.push_back(new_dfa.states[j]);
-				}
-				if (j > i && i != count - 1) {
-					new_states.emplace_back(new_dfa.states[j].index - 1,
-											new_dfa.states[j].label,
-											new_dfa.states[j].identifier,
-											new_dfa.states[j].is_terminal,
-											new_dfa.states[j].transitions);
-				}
-			}
-			if (new_dfa.initial_state > i)
-				new_dfa.initial_state -= 1;
-			new_dfa.states = new_states;
-			for (int j = 0; j < new_dfa.size(); j++) {
-				FAState::Transitions new_transitions;
-				for (auto& transition : new_dfa.states[j].transitions) {
-					set<int> new_transition;
-					for (int transition_to : transition.second) {
-						if (transition_to < i) {
-							new_transition.insert(transition_to);
-						}
-						if (transition_to > i) {
-							new_transition.insert(transition_to - 1);
-						}
-					}
-					if (!new_transition.empty())
-						new_transitions[transition.first] = new_transition;
-				}
-				new_dfa.states[j].transitions = new_transitions;
-			}
-			i--;
-			count--;
-		}
-	}
+	// достижимые состояния сохраняют порядок и нумеруются подряд
+	set<int> reachable_states = closure({initial_state}, false);
+	if (reachable_states.size() == states.size())
+		return *this;
+	vector<int> new_indices(states.size(), -1);
+	int counter = 0;
+	for (int state : reachable_states)
+		new_indices[state] = counter++;
+	vector<FAState> new_states;
+	for (int state : reachable_states) {
+		FAState::Transitions new_transitions;
+		for (const auto& [symb, states_to] : states[state].transitions) {
+			set<int> new_transition;
+			for (int transition_to : states_to)
+				new_transition.insert(new_indices[transition_to]);
+			if (!new_transition.empty())
+				new_transitions[symb] = new_transition;
+		}
+		new_states.emplace_back(new_indices[state],
+								states[state].label,
+								states[state].identifier,
+								states[state].is_terminal,
+								new_transitions);
+	}
+	FiniteAutomaton new_dfa(new_indices[initial_state], new_states, language);
 	if (new_dfa.is_empty())
-		new_dfa = *this;
+		return *this;
 	return new_dfa;
 }
 
@@ -1398,21 +1553,249 @@ tuple<FiniteAutomaton, unordered_map<int, int>> FiniteAutomaton::merge_classes(
 	return {{class_to_index.at(classes[initial_state]), new_states, language}, class_to_index};
 }
 
-vector<int> FiniteAutomaton::get_bisimulation_classes() const {
-	vector<RLGrammar::Item> fa_items;
-	vector<RLGrammar::Item*> nonterminals;
-	vector<RLGrammar::Item*> terminals;
-	vector<vector<vector<RLGrammar::Item*>>> rules = RLGrammar::fa_to_grammar(
-		states, language->get_alphabet(), fa_items, nonterminals, terminals);
-	vector<RLGrammar::Item*> bisimilar_nonterminals;
-	map<int, vector<RLGrammar::Item*>> class_to_nonterminals;
-	vector<vector<vector<RLGrammar::Item*>>> bisimilar_rules = RLGrammar::get_bisimilar_grammar(
-		rules, nonterminals, bisimilar_nonterminals, class_to_nonterminals);
+Partition FiniteAutomaton::get_bisimulation_partition(const FrozenAutomaton& frozen) {
+	int states_number = frozen.size();
+	int symbols_number = frozen.symbols_number();
+	int transitions_number = frozen.transitions_number();
+
+	// переход tr - (from[tr], symbol[tr], to[tr]); counter[tr] - номер счётчика числа переходов
+	// из from[tr] по symbol[tr] в составной блок, содержащий to[tr]
+	vector<int> from(transitions_number), symbol(transitions_number), to(transitions_number);
+	vector<int> counter(transitions_number);
+	vector<int> counts, counter_state;
+	int tr = 0;
+	for (int state = 0; state < states_number; state++)
+		for (int symb_id = 0; symb_id < symbols_number; symb_id++) {
+			auto targets = frozen.get_transitions(state, symb_id);
+			if (targets.empty())
+				continue;
+			int c = static_cast<int>(counts.size());
+			counts.push_back(targets.size());
+			counter_state.push_back(state);
+			for (int target : targets) {
+				from[tr] = state;
+				symbol[tr] = symb_id;
+				to[tr] = target;
+				counter[tr] = c;
+				tr++;
+			}
+		}
+	// входящие переходы каждого состояния
+	vector<int> in_offsets(states_number + 1, 0);
+	for (int i = 0; i < transitions_number; i++)
+		in_offsets[to[i] + 1]++;
+	for (int i = 0; i < states_number; i++)
+		in_offsets[i + 1] += in_offsets[i];
+	vector<int> incoming(transitions_number);
+	vector<int> positions(in_offsets.begin(), in_offsets.end() - 1);
+	for (int i = 0; i < transitions_number; i++)
+		incoming[positions[to[i]]++] = i;
+
+	// начальное разбиение устойчиво относительно множества всех состояний
+	Partition partition(states_number);
+	for (int state = 0; state < states_number; state++)
+		if (frozen.is_terminal(state))
+			partition.mark(state);
+	partition.split();
+	for (int symb_id = 0; symb_id < symbols_number; symb_id++) {
+		for (int state = 0; state < states_number; state++)
+			if (!frozen.get_transitions(state, symb_id).empty())
+				partition.mark(state);
+		partition.split();
+	}
+
+	// составные блоки - объединения блоков разбиения, относительно которых оно устойчиво;
+	// compounds - составные блоки, которые могут состоять из нескольких блоков
+	vector<vector<int>> compound_blocks(1);
+	vector<int> block_compound(partition.size(), 0);
+	vector<int> block_position(partition.size());
+	for (int b = 0; b < partition.size(); b++) {
+		block_position[b] = b;
+		compound_blocks[0].push_back(b);
+	}
+	vector<int> compounds = {0};
+	vector<char> in_compounds = {true};
+	auto add_blocks = [&](const vector<pair<int, int>>& splits) {
+		for (auto [old_block, new_block] : splits) {
+			int compound = block_compound[old_block];
+			block_compound.push_back(compound);
+			block_position.push_back(static_cast<int>(compound_blocks[compound].size()));
+			compound_blocks[compound].push_back(new_block);
+			if (!in_compounds[compound]) {
+				in_compounds[compound] = true;
+				compounds.push_back(compound);
+			}
+		}
+	};
 
-	vector<int> classes;
-	for (const auto& nont : nonterminals)
-		classes.push_back(nont->class_number);
+	vector<vector<int>> buckets(symbols_number);
+	vector<int> touched_symbols;
+	vector<int> split_counter(counts.size(), -1);
+	vector<int> touched_counters;
+	vector<int> splitter_states;
+	while (!compounds.empty()) {
+		int compound = compounds.back();
+		vector<int>& blocks = compound_blocks[compound];
+		if (blocks.size() < 2) {
+			compounds.pop_back();
+			in_compounds[compound] = false;
+			continue;
+		}
+		// блок-разделитель B не больше половины составного блока S, он становится отдельным
+		// составным блоком
+		int splitter = blocks[0];
+		if (partition.block_size(blocks[1]) < partition.block_size(splitter))
+			splitter = blocks[1];
+		blocks[block_position[splitter]] = blocks.back();
+		block_position[blocks.back()] = block_position[splitter];
+		blocks.pop_back();
+		block_compound[splitter] = static_cast<int>(compound_blocks.size());
+		block_position[splitter] = 0;
+		compound_blocks.push_back({splitter});
+		in_compounds.push_back(false);
+
+		// входящие в B переходы по символам
+		splitter_states.assign(partition.begin(splitter), partition.end(splitter));
+		for (int state : splitter_states)
+			for (int i = in_offsets[state]; i < in_offsets[state + 1]; i++) {
+				if (buckets[symbol[incoming[i]]].empty())
+					touched_symbols.push_back(symbol[incoming[i]]);
+				buckets[symbol[incoming[i]]].push_back(incoming[i]);
+			}
+
+		for (int symb_id : touched_symbols) {
+			vector<int>& bucket = buckets[symb_id];
+			// разделение по прообразу B
+			for (int t : bucket) {
+				int c = counter[t];
+				if (split_counter[c] == -1) {
+					split_counter[c] = static_cast<int>(counts.size());
+					counts.push_back(0);
+					counter_state.push_back(counter_state[c]);
+					split_counter.push_back(-1);
+					touched_counters.push_back(c);
+				}
+				counts[split_counter[c]]++;
+				partition.mark(from[t]);
+			}
+			add_blocks(partition.split());
+			// разделение по прообразу S \ B: отделяются состояния, все переходы которых в S
+			// ведут в B
+			for (int c : touched_counters)
+				if (counts[c] == counts[split_counter[c]])
+					partition.mark(counter_state[c]);
+			add_blocks(partition.split());
 
+			for (int t : bucket)
+				counter[t] = split_counter[counter[t]];
+			for (int c : touched_counters) {
+				counts[c] -= counts[split_counter[c]];
+				split_counter[c] = -1;
+			}
+			touched_counters.clear();
+			bucket.clear();
+		}
+		touched_symbols.clear();
+	}
+	return partition;
+}
+
+vector<int> FiniteAutomaton::get_bisimulation_classes(int initial_class) const {
+	FrozenAutomaton frozen = freeze();
+	Partition partition = get_bisimulation_partition(frozen);
+	int blocks_number = partition.size();
+
+	// на каждом шаге уточнения бисимилярные состояния получают одинаковые множества правил,
+	// поэтому нумерация классов воспроизводится на факторавтомате
+	vector<string> symbol_names;
+	for (int symb_id = 0; symb_id < frozen.symbols_number(); symb_id++)
+		symbol_names.push_back(frozen.get_symbol(symb_id));
+	vector<vector<pair<int, int>>> block_transitions(blocks_number);
+	vector<char> block_terminal(blocks_number);
+	for (int b = 0; b < blocks_number; b++) {
+		int state = *partition.begin(b);
+		block_terminal[b] = frozen.is_terminal(state);
+		for (int symb_id = 0; symb_id < frozen.symbols_number(); symb_id++)
+			for (int to : frozen.get_transitions(state, symb_id))
+				block_transitions[b].emplace_back(symb_id, partition.block(to));
+		std::sort(block_transitions[b].begin(), block_transitions[b].end());
+		block_transitions[b].erase(
+			std::unique(block_transitions[b].begin(), block_transitions[b].end()),
+			block_transitions[b].end());
+	}
+
+	// правило - строка из терминала и номера класса нетерминала, как в
+	// RLGrammar::check_classes; строка строится один раз для каждого различного правила
+	// (symb_id, номер класса), заключительность - правило (-1, 0)
+	vector<int> block_class(blocks_number, initial_class);
+	vector<vector<int>> block_rules(blocks_number);
+	vector<pair<int, int>> rules;
+	vector<string> rule_strings;
+	vector<int> rule_order, rule_rank;
+	vector<int> order(blocks_number);
+	int classes_number = -1;
+	while (true) {
+		rules.clear();
+		for (int b = 0; b < blocks_number; b++) {
+			for (auto [symb_id, to] : block_transitions[b])
+				rules.emplace_back(symb_id, block_class[to]);
+			if (block_terminal[b])
+				rules.emplace_back(-1, 0);
+		}
+		std::sort(rules.begin(), rules.end());
+		rules.erase(std::unique(rules.begin(), rules.end()), rules.end());
+		rule_strings.resize(rules.size());
+		rule_order.resize(rules.size());
+		rule_rank.resize(rules.size());
+		for (int i = 0; i < rules.size(); i++) {
+			rule_strings[i] = rules[i].first == -1
+								  ? Symbol::Epsilon
+								  : symbol_names[rules[i].first] + to_string(rules[i].second);
+			rule_order[i] = i;
+		}
+		std::sort(rule_order.begin(), rule_order.end(), [&rule_strings](int r1, int r2) {
+			return rule_strings[r1] < rule_strings[r2];
+		});
+		// совпадающие строки получают один ранг
+		for (int i = 0; i < rules.size(); i++)
+			rule_rank[rule_order[i]] =
+				i > 0 && rule_strings[rule_order[i]] == rule_strings[rule_order[i - 1]]
+					? rule_rank[rule_order[i - 1]]
+					: i;
+		auto rank = [&rules, &rule_rank](pair<int, int> rule) {
+			return rule_rank[std::lower_bound(rules.begin(), rules.end(), rule) - rules.begin()];
+		};
+		for (int b = 0; b < blocks_number; b++) {
+			block_rules[b].clear();
+			for (auto [symb_id, to] : block_transitions[b])
+				block_rules[b].push_back(rank({symb_id, block_class[to]}));
+			if (block_terminal[b])
+				block_rules[b].push_back(rank({-1, 0}));
+			std::sort(block_rules[b].begin(), block_rules[b].end());
+			block_rules[b].erase(std::unique(block_rules[b].begin(), block_rules[b].end()),
+								 block_rules[b].end());
+		}
+		for (int b = 0; b < blocks_number; b++)
+			order[b] = b;
+		std::sort(order.begin(), order.end(), [&block_rules](int b1, int b2) {
+			return block_rules[b1] < block_rules[b2];
+		});
+		int new_classes_number = 0;
+		for (int i = 0; i < blocks_number; i++) {
+			if (i > 0 && block_rules[order[i]] != block_rules[order[i - 1]])
+				new_classes_number++;
+			block_class[order[i]] = new_classes_number;
+		}
+		if (blocks_number > 0)
+			new_classes_number++;
+		if (new_classes_number == classes_number)
+			break;
+		classes_number = new_classes_number;
+	}
+
+	vector<int> classes(states.size());
+	for (int i = 0; i < states.size(); i++)
+		classes[i] = block_class[partition.block(i)];
 	return classes;
 }
 
@@ -1421,12 +1804,14 @@ FiniteAutomaton FiniteAutomaton::merge_bisimilar(iLogTemplate* log) const {
 	vector<int> classes = get_bisimulation_classes();
 	auto [result, class_to_index] = merge_classes(classes);
 
+	vector<int> class_sizes(classes.size());
+	for (int i = 0; i < classes.size(); i++)
+		class_sizes[classes[i]]++;
 	for (int i = 0; i < classes.size(); i++) {
-		for (int j = 0; j < classes.size(); j++)
-			if (classes[i] == classes[j] && (i != j)) {
-				old_meta.upd(NodeMeta{i, classes[i]});
-				new_meta.upd(NodeMeta{class_to_index.at(classes[i]), classes[i]});
-			}
+		if (class_sizes[classes[i]] > 1) {
+			old_meta.upd(NodeMeta{i, classes[i]});
+			new_meta.upd(NodeMeta{class_to_index.at(classes[i]), classes[i]});
+		}
 	}
 
 	map<int, vector<int>> class_to_indexes;
@@ -1451,99 +1836,70 @@ FiniteAutomaton FiniteAutomaton::merge_bisimilar(iLogTemplate* log) const {
 
 tuple<bool, pair<MetaInfo, MetaInfo>, vector<vector<int>>> FiniteAutomaton::bisimilarity_checker(
 	const FiniteAutomaton& fa1, const FiniteAutomaton& fa2) {
-	// грамматики из автоматов
-	vector<RLGrammar::Item> fa1_items;
-	vector<RLGrammar::Item*> fa1_nonterminals;
-	vector<RLGrammar::Item*> fa1_terminals;
-	vector<vector<vector<RLGrammar::Item*>>> fa1_rules = RLGrammar::fa_to_grammar(
-		fa1.states, fa1.language->get_alphabet(), fa1_items, fa1_nonterminals, fa1_terminals);
-
-	vector<RLGrammar::Item> fa2_items;
-	vector<RLGrammar::Item*> fa2_nonterminals;
-	vector<RLGrammar::Item*> fa2_terminals;
-	vector<vector<vector<RLGrammar::Item*>>> fa2_rules = RLGrammar::fa_to_grammar(
-		fa2.states, fa2.language->get_alphabet(), fa2_items, fa2_nonterminals, fa2_terminals);
-
-	MetaInfo meta1, meta2;
-	if (fa1_terminals.size() != fa2_terminals.size())
+	if (fa1.language->get_alphabet() != fa2.language->get_alphabet())
 		return {false, {}, {}};
-	for (int i = 0; i < fa1_terminals.size(); i++)
-		if (*fa1_terminals[i] != *fa2_terminals[i])
-			return {false, {}, {}};
-	// сначала получаем бисимилярные грамматики из данных автоматов
-	vector<RLGrammar::Item*> fa1_bisimilar_nonterminals;
-	map<int, vector<RLGrammar::Item*>> fa1_class_to_nonterminals;
-	vector<vector<vector<RLGrammar::Item*>>> fa1_bisimilar_rules = RLGrammar::get_bisimilar_grammar(
-		fa1_rules, fa1_nonterminals, fa1_bisimilar_nonterminals, fa1_class_to_nonterminals);
-
-	vector<RLGrammar::Item*> fa2_bisimilar_nonterminals;
-	map<int, vector<RLGrammar::Item*>> fa2_class_to_nonterminals;
-	vector<vector<vector<RLGrammar::Item*>>> fa2_bisimilar_rules = RLGrammar::get_bisimilar_grammar(
-		fa2_rules, fa2_nonterminals, fa2_bisimilar_nonterminals, fa2_class_to_nonterminals);
-	if (fa1_bisimilar_nonterminals.size() != fa2_bisimilar_nonterminals.size())
+	// сначала получаем классы бисимуляции каждого автомата
+	vector<int> fa1_classes = fa1.get_bisimulation_classes();
+	vector<int> fa2_classes = fa2.get_bisimulation_classes();
+	auto [fa1_bisimilar, fa1_class_to_index] = fa1.merge_classes(fa1_classes);
+	auto [fa2_bisimilar, fa2_class_to_index] = fa2.merge_classes(fa2_classes);
+	if (fa1_bisimilar.size() != fa2_bisimilar.size())
 		return {false, {}, {}};
-	// из объединения полученных ранее получаем итоговую
-	// ! порядок нетерминалов соответствует порядку правил
-	vector<RLGrammar::Item*> nonterminals(fa1_bisimilar_nonterminals);
-	nonterminals.insert(
-		nonterminals.end(), fa2_bisimilar_nonterminals.begin(), fa2_bisimilar_nonterminals.end());
-	vector<vector<vector<RLGrammar::Item*>>> rules(fa1_bisimilar_rules);
-	rules.insert(rules.end(), fa2_bisimilar_rules.begin(), fa2_bisimilar_rules.end());
-
-	vector<int> fa1_classes; // сохраняю классы
-	for (RLGrammar::Item* nont : fa1_nonterminals) {
-		fa1_classes.push_back(nont->class_number);
-		nont->class_number = -1; // сбрасываю номера классов
-	}
-	vector<int> fa2_classes; // сохраняю классы
-	for (RLGrammar::Item* nont : fa2_nonterminals) {
-		fa2_classes.push_back(nont->class_number);
-		nont->class_number = -1; // сбрасываю номера классов
-	}
-
-	vector<RLGrammar::Item*> bisimilar_nonterminals;
-	map<int, vector<RLGrammar::Item*>> class_to_nonterminals;
-	vector<vector<vector<RLGrammar::Item*>>> bisimilar_rules = RLGrammar::get_bisimilar_grammar(
-		rules, nonterminals, bisimilar_nonterminals, class_to_nonterminals);
-
-	//	map<int, vector<string>> class_to_nonterminals_names;
 
-	for (int i = 0; i < fa1_nonterminals.size(); i++) {
-		int nont_class = fa1_class_to_nonterminals.at(fa1_classes[i])[0]
-							 ->class_number; // класс нетерминала в общей грамматике,
-											 // 0й элемент попал в бисимилярную грамматику
-		meta1.upd(NodeMeta{i, nont_class});
-		// class_to_nonterminals_names[nont_class].push_back("FA1:" + fa1_nonterminals[i]->name);
-	}
+	// затем классы бисимуляции объединения факторавтоматов
+	// ! состояние факторавтомата совпадает с номером класса
+	int shift = fa1_bisimilar.size();
+	vector<int> joint_classes =
+		get_disjoint_union(fa1_bisimilar, fa2_bisimilar).get_bisimulation_classes(-1);
 
-	for (int i = 0; i < fa2_nonterminals.size(); i++) {
-		int nont_class = fa2_class_to_nonterminals.at(fa2_classes[i])[0]
-							 ->class_number; // класс нетерминала в общей грамматике,
-											 // 0й элемент попал в бисимилярную грамматику
-		meta2.upd(NodeMeta{i, nont_class});
-		// class_to_nonterminals_names[nont_class].push_back("FA2:" + fa2_nonterminals[i]->name);
-	}
-	// log
-	//	stringstream ss;
-	//	for (auto& elem : class_to_nonterminals_names) {
-	//		ss << "{";
-	//		for (int i = 0; i < elem.second.size() - 1; i++)
-	//			ss << elem.second[i] << ",";
-	//		ss << elem.second[elem.second.size() - 1] << "}";
-	//	}
+	MetaInfo meta1, meta2;
+	for (int i = 0; i < fa1_classes.size(); i++)
+		meta1.upd(NodeMeta{i, joint_classes[fa1_classes[i]]});
+	for (int i = 0; i < fa2_classes.size(); i++)
+		meta2.upd(NodeMeta{i, joint_classes[fa2_classes[i] + shift]});
 
 	// проверяю равенство классов начальных состояний
-	if (fa1_nonterminals[fa1.initial_state]->class_number !=
-		fa2_nonterminals[fa2.initial_state]->class_number)
+	if (joint_classes[fa1_classes[fa1.initial_state]] !=
+		joint_classes[fa2_classes[fa2.initial_state] + shift])
 		return {false, {}, {}};
-	if (fa1_bisimilar_nonterminals.size() != bisimilar_nonterminals.size())
+	if (*std::max_element(joint_classes.begin(), joint_classes.end()) + 1 != shift)
 		return {false, {}, {}};
 
 	return {true, {meta1, meta2}, {fa1_classes, fa2_classes}};
 }
 
+FiniteAutomaton FiniteAutomaton::get_disjoint_union(const FiniteAutomaton& fa1,
+													const FiniteAutomaton& fa2) {
+	int shift = fa1.size();
+	vector<FAState> states(fa1.states);
+	for (const auto& state : fa2.states) {
+		FAState new_state(state.index + shift, state.identifier, state.is_terminal);
+		for (const auto& [symbol, symbol_transitions] : state.transitions)
+			for (int transition_to : symbol_transitions)
+				new_state.transitions[symbol].insert(transition_to + shift);
+		states.push_back(new_state);
+	}
+	return {fa1.initial_state, states, fa1.language};
+}
+
 bool FiniteAutomaton::bisimilar(const FiniteAutomaton& fa1, const FiniteAutomaton& fa2,
 								iLogTemplate* log) {
+	if (!log) {
+		// нумерация классов нужна только для лога: достаточно разбиения объединения автоматов,
+		// в котором каждый класс содержит состояния обоих автоматов
+		if (fa1.language->get_alphabet() != fa2.language->get_alphabet())
+			return false;
+		int shift = fa1.size();
+		Partition partition = get_bisimulation_partition(get_disjoint_union(fa1, fa2).freeze());
+		if (partition.block(fa1.initial_state) != partition.block(fa2.initial_state + shift))
+			return false;
+		vector<char> in_fa1(partition.size(), false), in_fa2(partition.size(), false);
+		for (int i = 0; i < shift; i++)
+			in_fa1[partition.block(i)] = true;
+		for (int i = 0; i < fa2.size(); i++)
+			in_fa2[partition.block(i + shift)] = true;
+		return in_fa1 == in_fa2;
+	}
 	auto [result, meta, _] = bisimilarity_checker(fa1, fa2);
 	if (log) {
 		log->set_parameter("automaton1", fa1, meta.first);
@@ -1719,11 +2075,16 @@ bool FiniteAutomaton::equivalent(const FiniteAutomaton& fa1, const FiniteAutomat
 			log->set_parameter("samelanguage",
 							   "(!) автоматы изначально принадлежат одному языку"); // TODO:
 																					// logs
-	} else {
-		if ((!fa1.language->is_min_dfa_cached() || !fa2.language->is_min_dfa_cached()) && log) {
+	} else if (log) {
+		// в лог попадает сообщение о кэшировании минимальных автоматов
+		if (!fa1.language->is_min_dfa_cached() || !fa2.language->is_min_dfa_cached()) {
 			log->set_parameter("cachedMINDFA", "Минимальные автоматы сохранены в кэше");
 		}
 		result = bisimilar(fa1.minimize(), fa2.minimize());
+	} else {
+		// минимальные ДКА над разными алфавитами не бисимилярны
+		result = fa1.language->get_alphabet() == fa2.language->get_alphabet() &&
+				 !find_equivalence_counterexample(fa1, fa2);
 	}
 	if (log) {
 		log->set_parameter("automaton1", fa1);
@@ -1733,9 +2094,249 @@ bool FiniteAutomaton::equivalent(const FiniteAutomaton& fa1, const FiniteAutomat
 	return result;
 }
 
+std::optional<std::string> FiniteAutomaton::find_equivalence_counterexample(
+	const FiniteAutomaton& fa1, const FiniteAutomaton& fa2) {
+	// макросостояния обоих автоматов - подмножества состояний их несвязного объединения
+	int shift = fa1.size();
+	FrozenAutomaton frozen = get_disjoint_union(fa1, fa2).freeze();
+	EpsilonClosures closures(frozen);
+	Alphabet alphabet = fa1.language->get_alphabet();
+	for (const Symbol& symb : fa2.language->get_alphabet())
+		alphabet.insert(symb);
+	vector<Symbol> symbols(alphabet.begin(), alphabet.end());
+	int alphabet_size = static_cast<int>(symbols.size());
+	vector<int> symbol_ids(alphabet_size);
+	for (int symb_id = 0; symb_id < alphabet_size; symb_id++)
+		symbol_ids[symb_id] = frozen.get_symbol_id(symbols[symb_id]);
+
+	// ленивая определизация и система непересекающихся множеств над макросостояниями
+	SubsetTable macrostates;
+	vector<char> accepting;
+	vector<int> successors;
+	vector<int> parents;
+	vector<int> ranks;
+	auto add_macrostate = [&](const vector<int>& subset) {
+		auto [index, inserted] = macrostates.insert(subset);
+		if (inserted) {
+			accepting.push_back(std::any_of(subset.begin(), subset.end(), [&](int state) {
+				return frozen.is_terminal(state);
+			}));
+			successors.resize(successors.size() + alphabet_size, SubsetTable::NotFound);
+			parents.push_back(index);
+			ranks.push_back(0);
+		}
+		return index;
+	};
+	vector<int> visited(frozen.size(), -1);
+	int stamp = 0;
+	vector<int> subset;
+	auto get_successor = [&](int macrostate, int symb_id) {
+		if (int successor = successors[macrostate * alphabet_size + symb_id];
+			successor != SubsetTable::NotFound)
+			return successor;
+		subset.clear();
+		if (symbol_ids[symb_id] != FrozenAutomaton::NoSymbol) {
+			for (int state : macrostates.get(macrostate))
+				for (int to : frozen.get_transitions(state, symbol_ids[symb_id]))
+					for (int closure_state : closures.get(to))
+						if (visited[closure_state] != stamp) {
+							visited[closure_state] = stamp;
+							subset.push_back(closure_state);
+						}
+			stamp++;
+			std::sort(subset.begin(), subset.end());
+		}
+		int successor = add_macrostate(subset);
+		successors[macrostate * alphabet_size + symb_id] = successor;
+		return successor;
+	};
+	auto find = [&](int macrostate) {
+		while (parents[macrostate] != macrostate) {
+			parents[macrostate] = parents[parents[macrostate]];
+			macrostate = parents[macrostate];
+		}
+		return macrostate;
+	};
+	// false, если макросостояния уже были в одном множестве
+	auto unite = [&](int macrostate1, int macrostate2) {
+		macrostate1 = find(macrostate1);
+		macrostate2 = find(macrostate2);
+		if (macrostate1 == macrostate2)
+			return false;
+		if (ranks[macrostate1] < ranks[macrostate2])
+			std::swap(macrostate1, macrostate2);
+		parents[macrostate2] = macrostate1;
+		if (ranks[macrostate1] == ranks[macrostate2])
+			ranks[macrostate1]++;
+		return true;
+	};
+
+	// алгоритм Хопкрофта-Карпа: пары макросостояний, достижимые по одному слову, объединяются;
+	// пара, которая уже лежит в одном множестве, не рассматривается повторно.
+	// Обход в ширину, поэтому первая пара с разной допустимостью даёт кратчайшее различающее слово
+	struct Node {
+		int macrostate1;
+		int macrostate2;
+		int parent;
+		int symb_id;
+	};
+	vector<Node> nodes;
+	auto add_node = [&](const Node& node) {
+		if (!unite(node.macrostate1, node.macrostate2))
+			return false;
+		nodes.push_back(node);
+		return accepting[node.macrostate1] != accepting[node.macrostate2];
+	};
+	auto get_word = [&](int node) {
+		vector<int> word_symbols;
+		for (; nodes[node].parent != -1; node = nodes[node].parent)
+			word_symbols.push_back(nodes[node].symb_id);
+		string word;
+		for (auto it = word_symbols.rbegin(); it != word_symbols.rend(); it++)
+			word += string(symbols[*it]);
+		return word;
+	};
+
+	int initial_macrostate1 =
+		add_macrostate(fa1.states.empty() ? vector<int>() : closures.get(fa1.initial_state));
+	int initial_macrostate2 = add_macrostate(
+		fa2.states.empty() ? vector<int>() : closures.get(fa2.initial_state + shift));
+	if (add_node({initial_macrostate1, initial_macrostate2, -1, -1}))
+		return get_word(0);
+	for (int node = 0; node < nodes.size(); node++) {
+		for (int symb_id = 0; symb_id < alphabet_size; symb_id++) {
+			int next_macrostate1 = get_successor(nodes[node].macrostate1, symb_id);
+			int next_macrostate2 = get_successor(nodes[node].macrostate2, symb_id);
+			if (add_node({next_macrostate1, next_macrostate2, node, symb_id}))
+				return get_word(static_cast<int>(nodes.size()) - 1);
+		}
+	}
+	return std::nullopt;
+}
+
+std::optional<std::string> FiniteAutomaton::find_subset_counterexample(
+	const FiniteAutomaton& fa) const {
+	if (fa.states.empty())
+		return std::nullopt;
+	FrozenAutomaton frozen_fa = fa.freeze();
+	FrozenAutomaton frozen = freeze();
+	std::shared_ptr<const EpsilonClosures> fa_closures = fa.get_epsilon_closures();
+	std::shared_ptr<const EpsilonClosures> closures = get_epsilon_closures();
+	// переходы по символам, которых нет в this, ведут в пустое макросостояние
+	int alphabet_size = frozen_fa.get_alphabet_size();
+	vector<int> symbol_ids(alphabet_size);
+	for (int symb_id = 0; symb_id < alphabet_size; symb_id++)
+		symbol_ids[symb_id] = frozen.get_symbol_id(frozen_fa.get_symbol(symb_id));
+
+	// ленивая определизация this: макросостояния и уже построенные переходы между ними
+	SubsetTable macrostates;
+	vector<char> accepting;
+	vector<int> successors;
+	auto add_macrostate = [&](const vector<int>& subset) {
+		auto [index, inserted] = macrostates.insert(subset);
+		if (inserted) {
+			accepting.push_back(std::any_of(subset.begin(), subset.end(), [&](int state) {
+				return frozen.is_terminal(state);
+			}));
+			successors.resize(successors.size() + alphabet_size, SubsetTable::NotFound);
+		}
+		return index;
+	};
+	vector<int> visited(frozen.size(), -1);
+	int stamp = 0;
+	vector<int> subset;
+	auto get_successor = [&](int macrostate, int symb_id) {
+		if (int successor = successors[macrostate * alphabet_size + symb_id];
+			successor != SubsetTable::NotFound)
+			return successor;
+		subset.clear();
+		if (symbol_ids[symb_id] != FrozenAutomaton::NoSymbol) {
+			for (int state : macrostates.get(macrostate))
+				for (int to : frozen.get_transitions(state, symbol_ids[symb_id]))
+					for (int closure_state : closures->get(to))
+						if (visited[closure_state] != stamp) {
+							visited[closure_state] = stamp;
+							subset.push_back(closure_state);
+						}
+			stamp++;
+			std::sort(subset.begin(), subset.end());
+		}
+		int successor = add_macrostate(subset);
+		successors[macrostate * alphabet_size + symb_id] = successor;
+		return successor;
+	};
+
+	// вершины произведения: состояние fa и макросостояние this после чтения одного слова;
+	// обход в ширину, поэтому первый найденный контрпример - кратчайший
+	struct Node {
+		int state;
+		int macrostate;
+		int parent;
+		int symb_id;
+	};
+	vector<Node> nodes;
+	// антицепь: для каждого состояния fa минимальные по включению макросостояния.
+	// Если из (p, S) достижим контрпример, то он достижим и из (p, S') при S' ⊆ S,
+	// поэтому вершины, поглощаемые антицепью, не рассматриваются
+	vector<vector<int>> antichains(frozen_fa.size());
+	auto includes = [&](int macrostate1, int macrostate2) {
+		SubsetTable::Subset subset1 = macrostates.get(macrostate1);
+		SubsetTable::Subset subset2 = macrostates.get(macrostate2);
+		return std::includes(subset1.begin(), subset1.end(), subset2.begin(), subset2.end());
+	};
+	auto add_node = [&](const Node& node) {
+		vector<int>& antichain = antichains[node.state];
+		for (int macrostate : antichain)
+			if (includes(node.macrostate, macrostate))
+				return false;
+		antichain.erase(std::remove_if(antichain.begin(),
+									   antichain.end(),
+									   [&](int macrostate) {
+										   return includes(macrostate, node.macrostate);
+									   }),
+						antichain.end());
+		antichain.push_back(node.macrostate);
+		nodes.push_back(node);
+		return frozen_fa.is_terminal(node.state) && !accepting[node.macrostate];
+	};
+	auto get_word = [&](int node) {
+		vector<int> symbols;
+		for (; nodes[node].parent != -1; node = nodes[node].parent)
+			symbols.push_back(nodes[node].symb_id);
+		string word;
+		for (auto it = symbols.rbegin(); it != symbols.rend(); it++)
+			word += string(frozen_fa.get_symbol(*it));
+		return word;
+	};
+
+	int initial_macrostate =
+		add_macrostate(states.empty() ? vector<int>() : closures->get(frozen.get_initial()));
+	for (int state : fa_closures->get(frozen_fa.get_initial()))
+		if (add_node({state, initial_macrostate, -1, -1}))
+			return get_word(static_cast<int>(nodes.size()) - 1);
+	for (int node = 0; node < nodes.size(); node++) {
+		for (int symb_id = 0; symb_id < alphabet_size; symb_id++) {
+			FrozenAutomaton::Targets targets =
+				frozen_fa.get_transitions(nodes[node].state, symb_id);
+			if (targets.empty())
+				continue;
+			int next_macrostate = get_successor(nodes[node].macrostate, symb_id);
+			for (int to : targets)
+				for (int state : fa_closures->get(to))
+					if (add_node({state, next_macrostate, node, symb_id}))
+						return get_word(static_cast<int>(nodes.size()) - 1);
+		}
+	}
+	return std::nullopt;
+}
+
 bool FiniteAutomaton::subset(const FiniteAutomaton& fa, iLogTemplate* log) const {
-	FiniteAutomaton fa_instersection(intersection(*this, fa));
-	bool result = equivalent(fa_instersection, fa);
+	// символы fa, которых нет в алфавите this, считаются невложенными
+	const Alphabet& alphabet = language->get_alphabet();
+	const Alphabet& fa_alphabet = fa.language->get_alphabet();
+	bool result = std::includes(
+					  alphabet.begin(), alphabet.end(), fa_alphabet.begin(), fa_alphabet.end()) &&
+				  !find_subset_counterexample(fa);
 	if (log) {
 		log->set_parameter("automaton1", *this);
 		log->set_parameter("automaton2", fa);
@@ -1744,23 +2345,108 @@ bool FiniteAutomaton::subset(const FiniteAutomaton& fa, iLogTemplate* log) const
 	return result;
 }
 
+namespace {
+// компоненты сильной связности графа (нерекурсивный алгоритм Тарьяна). Компоненты нумеруются
+// в обратном топологическом порядке: дуги ведут из компонент с большими номерами в меньшие
+vector<int> get_components(const vector<vector<int>>& graph) {
+	int vertices_number = static_cast<int>(graph.size());
+	vector<int> components(vertices_number, -1), order(vertices_number, -1), low(vertices_number);
+	vector<int> component_stack;
+	// (вершина, позиция следующей дуги)
+	vector<pair<int, int>> dfs_stack;
+	int counter = 0, components_number = 0;
+	auto enter = [&](int vertex) {
+		order[vertex] = low[vertex] = counter++;
+		component_stack.push_back(vertex);
+		dfs_stack.emplace_back(vertex, 0);
+	};
+	for (int root = 0; root < vertices_number; root++) {
+		if (order[root] != -1)
+			continue;
+		enter(root);
+		while (!dfs_stack.empty()) {
+			auto [vertex, edge] = dfs_stack.back();
+			if (edge < graph[vertex].size()) {
+				dfs_stack.back().second++;
+				int to = graph[vertex][edge];
+				if (order[to] == -1)
+					enter(to);
+				else if (components[to] == -1)
+					low[vertex] = std::min(low[vertex], order[to]);
+				continue;
+			}
+			dfs_stack.pop_back();
+			if (!dfs_stack.empty()) {
+				int parent = dfs_stack.back().first;
+				low[parent] = std::min(low[parent], low[vertex]);
+			}
+			if (low[vertex] != order[vertex])
+				continue;
+			int member;
+			do {
+				member = component_stack.back();
+				component_stack.pop_back();
+				components[member] = components_number;
+			} while (member != vertex);
+			components_number++;
+		}
+	}
+	return components;
+}
+
+// состояния, достижимые из начального, из которых достижимо финальное
+vector<char> get_useful_states(const FrozenAutomaton& frozen) {
+	int states_number = frozen.size();
+	vector<vector<int>> reversed(states_number);
+	for (int state = 0; state < states_number; state++)
+		for (int to : frozen.get_transitions(state))
+			reversed[to].push_back(state);
+	vector<char> reachable(states_number), coreachable(states_number);
+	vector<int> queue;
+	if (states_number > 0) {
+		reachable[frozen.get_initial()] = true;
+		queue.push_back(frozen.get_initial());
+	}
+	for (int i = 0; i < queue.size(); i++)
+		for (int to : frozen.get_transitions(queue[i]))
+			if (!reachable[to]) {
+				reachable[to] = true;
+				queue.push_back(to);
+			}
+	queue.clear();
+	for (int state = 0; state < states_number; state++)
+		if (frozen.is_terminal(state)) {
+			coreachable[state] = true;
+			queue.push_back(state);
+		}
+	for (int i = 0; i < queue.size(); i++)
+		for (int from : reversed[queue[i]])
+			if (!coreachable[from]) {
+				coreachable[from] = true;
+				queue.push_back(from);
+			}
+	vector<char> useful(states_number);
+	for (int state = 0; state < states_number; state++)
+		useful[state] = reachable[state] && coreachable[state];
+	return useful;
+}
+} // namespace
+
 Fraction calc_ambiguity(int i, int n, const vector<Fraction>& f1,
 						vector<vector<Fraction>>& calculated,  // NOLINT(runtime/references)
 						vector<vector<char>>& is_calculated) { // NOLINT(runtime/references)
 	if (i == 0)
 		return f1[n];
-	Fraction d1, d2;
 	if (!is_calculated[i][n + 1]) {
 		calculated[i][n + 1] = calc_ambiguity(i - 1, n + 1, f1, calculated, is_calculated);
 		is_calculated[i][n + 1] = 1;
 	}
-	d1 = calculated[i][n + 1];
 	if (!is_calculated[i][n]) {
 		calculated[i][n] = calc_ambiguity(i - 1, n, f1, calculated, is_calculated);
 		is_calculated[i][n] = 1;
 	}
-	d2 = calculated[i][n];
-	return d1 - d2;
+	// размеры таблиц не меняются при рекурсии, поэтому значения не копируются
+	return calculated[i][n + 1] - calculated[i][n];
 }
 
 FiniteAutomaton::AmbiguityValue FiniteAutomaton::get_ambiguity_value(
@@ -1774,14 +2460,14 @@ FiniteAutomaton::AmbiguityValue FiniteAutomaton::get_ambiguity_value(
 	int min_s = min_fa.size();
 	int N = s * s + s + i + 1;
 	// количество путей до финальных из начального
-	InfInt paths_number;
-	InfInt min_paths_number;
+	BigInt paths_number;
+	BigInt min_paths_number;
 	// матрица смежности
 	vector<vector<int>> adjacency_matrix(s, vector<int>(s));
 	vector<vector<int>> min_adjacency_matrix(min_s, vector<int>(min_s));
 	// количество путей длины n до всех вершин из начальной
-	vector<vector<InfInt>> d(2, vector<InfInt>(s));
-	vector<vector<InfInt>> min_d(2, vector<InfInt>(min_s));
+	vector<vector<BigInt>> d(2, vector<BigInt>(s));
+	vector<vector<BigInt>> min_d(2, vector<BigInt>(min_s));
 	d[0][fa.initial_state] = 1;
 	min_d[0][min_fa.initial_state] = 1;
 	for (int i = 0; i < s; i++)
@@ -1810,18 +2496,23 @@ FiniteAutomaton::AmbiguityValue FiniteAutomaton::get_ambiguity_value(
 	for (int k = 0; true; k++) {
 		paths_number = 0;
 		min_paths_number = 0;
-		d[(k + 1) % 2] = vector<InfInt>(s);
-		min_d[(k + 1) % 2] = vector<InfInt>(min_s);
+		// разряды чисел прошлого шага переиспользуются
+		for (auto& paths : d[(k + 1) % 2])
+			paths = 0;
+		for (auto& paths : min_d[(k + 1) % 2])
+			paths = 0;
 		for (int v = 0; v < s; v++) {
 			for (int i = 0; i < s; i++) {
-				d[(k + 1) % 2][v] += InfInt(adjacency_matrix[i][v]) * d[k % 2][i];
+				if (adjacency_matrix[i][v] && !d[k % 2][i].is_zero())
+					d[(k + 1) % 2][v] += d[k % 2][i] * adjacency_matrix[i][v];
 			}
 			if (fa.states[v].is_terminal)
 				paths_number += d[(k + 1) % 2][v];
 		}
 		for (int v = 0; v < min_s; v++) {
 			for (int i = 0; i < min_s; i++) {
-				min_d[(k + 1) % 2][v] += InfInt(min_adjacency_matrix[i][v]) * min_d[k % 2][i];
+				if (min_adjacency_matrix[i][v] && !min_d[k % 2][i].is_zero())
+					min_d[(k + 1) % 2][v] += min_d[k % 2][i] * min_adjacency_matrix[i][v];
 			}
 			if (min_fa.states[v].is_terminal)
 				min_paths_number += min_d[(k + 1) % 2][v];
@@ -1877,7 +2568,7 @@ FiniteAutomaton::AmbiguityValue FiniteAutomaton::get_ambiguity_value(
 				new_s + i, new_s * new_s + delta, f1_check, calculated_check, is_calculated_check);
 			// limit check
 			if (Fraction::last_number_of_digits >= digits_number_limit ||
-				double(paths_number.numberOfDigits() + min_paths_number.numberOfDigits()) >=
+				double(paths_number.digits_number() + min_paths_number.digits_number()) >=
 					double(digits_number_limit) / 2) {
 				word_length = k;
 				if (unambigious_return_flag)
@@ -1906,8 +2597,8 @@ FiniteAutomaton::AmbiguityValue FiniteAutomaton::get_ambiguity_value(
 				is_exponentially_ambiguous = false;
 			}
 			return_counter = 0;
-			calculated = calculated_check;
-			is_calculated = is_calculated_check;
+			calculated = std::move(calculated_check);
+			is_calculated = std::move(is_calculated_check);
 			f1.push_back(new_f1_value);
 			prev_val = val;
 		} else {
@@ -1918,6 +2609,220 @@ FiniteAutomaton::AmbiguityValue FiniteAutomaton::get_ambiguity_value(
 	return FiniteAutomaton::polynomially_ambigious;
 }
 
+FiniteAutomaton::AmbiguityValue FiniteAutomaton::get_structural_ambiguity_value() const {
+	FiniteAutomaton fa = remove_eps();
+	FrozenAutomaton frozen = fa.freeze();
+	int n = frozen.size();
+	vector<char> useful = get_useful_states(frozen);
+	if (n == 0 || !useful[frozen.get_initial()])
+		return FiniteAutomaton::unambigious;
+	vector<int> symbols;
+	for (int symb_id = 0; symb_id < frozen.symbols_number(); symb_id++)
+		if (symb_id != frozen.get_epsilon_id())
+			symbols.push_back(symb_id);
+
+	// A^2: пары полезных состояний, достижимые из (q0, q0) по одинаковым словам
+	vector<int> pair_ids(static_cast<size_t>(n) * n, -1);
+	vector<pair<int, int>> state_pairs;
+	vector<vector<int>> pair_graph;
+	auto add_pair = [&](int state1, int state2) {
+		int& id = pair_ids[static_cast<size_t>(state1) * n + state2];
+		if (id == -1) {
+			id = static_cast<int>(state_pairs.size());
+			state_pairs.emplace_back(state1, state2);
+			pair_graph.emplace_back();
+		}
+		return id;
+	};
+	add_pair(frozen.get_initial(), frozen.get_initial());
+	for (int i = 0; i < state_pairs.size(); i++) {
+		auto [state1, state2] = state_pairs[i];
+		for (int symb_id : symbols)
+			for (int to1 : frozen.get_transitions(state1, symb_id))
+				for (int to2 : frozen.get_transitions(state2, symb_id))
+					if (useful[to1] && useful[to2]) {
+						int to = add_pair(to1, to2);
+						pair_graph[i].push_back(to);
+					}
+	}
+	// полезные пары: из них достижима пара финальных состояний
+	int pairs_number = static_cast<int>(state_pairs.size());
+	vector<vector<int>> reversed_pair_graph(pairs_number);
+	for (int i = 0; i < pairs_number; i++)
+		for (int to : pair_graph[i])
+			reversed_pair_graph[to].push_back(i);
+	vector<char> useful_pair(pairs_number);
+	vector<int> queue;
+	for (int i = 0; i < pairs_number; i++)
+		if (frozen.is_terminal(state_pairs[i].first) && frozen.is_terminal(state_pairs[i].second)) {
+			useful_pair[i] = true;
+			queue.push_back(i);
+		}
+	for (int i = 0; i < queue.size(); i++)
+		for (int from : reversed_pair_graph[queue[i]])
+			if (!useful_pair[from]) {
+				useful_pair[from] = true;
+				queue.push_back(from);
+			}
+	// однозначность: у слова два разных успешных пути, только если они проходят через
+	// полезную пару различных состояний
+	bool is_ambiguous = false;
+	for (int i = 0; i < pairs_number; i++)
+		is_ambiguous |= useful_pair[i] && state_pairs[i].first != state_pairs[i].second;
+	if (!is_ambiguous)
+		return FiniteAutomaton::unambigious;
+
+	// EDA: компонента сильной связности полезной части A^2 содержит диагональную пару
+	// (p, p) и пару различных состояний
+	for (int i = 0; i < pairs_number; i++)
+		if (!useful_pair[i])
+			pair_graph[i].clear();
+		else
+			pair_graph[i].erase(std::remove_if(pair_graph[i].begin(),
+											   pair_graph[i].end(),
+											   [&](int to) { return !useful_pair[to]; }),
+								pair_graph[i].end());
+	vector<int> pair_components = get_components(pair_graph);
+	vector<char> has_diagonal(pairs_number), has_non_diagonal(pairs_number);
+	bool has_eda = false;
+	for (int i = 0; i < pairs_number; i++) {
+		if (!useful_pair[i])
+			continue;
+		int component = pair_components[i];
+		(state_pairs[i].first == state_pairs[i].second ? has_diagonal
+													   : has_non_diagonal)[component] = true;
+		has_eda |= has_diagonal[component] && has_non_diagonal[component];
+	}
+
+	// IDA: p != q и слово v с путями p -> p, p -> q, q -> q, т.е. путь из (p, p, q) в (p, q, q)
+	// в A^3. Если p и q в одной компоненте A, то есть и EDA, поэтому рассматриваются
+	// нетривиальные компоненты, из компоненты p достижима компонента q. На таком пути первая
+	// и третья тройки остаются в компонентах p и q, поэтому A^3 строится один раз из всех
+	// (p, p, q) только по дугам, не меняющим компоненты первого и третьего состояний. После
+	// добавления дуг (p, q, q) -> (p, p, q) путь есть, если (p, p, q) и (p, q, q) в одной
+	// компоненте (Аллозен-Мори-Растоги): путь через добавленные дуги склеивается в слово с
+	// путями p -> p, p -> q, q -> q
+	bool has_ida = false;
+	if (!has_eda) {
+		vector<vector<int>> graph(n);
+		for (int state = 0; state < n; state++)
+			if (useful[state])
+				for (int to : frozen.get_transitions(state))
+					if (useful[to])
+						graph[state].push_back(to);
+		vector<int> components = get_components(graph);
+		vector<char> is_nontrivial(n);
+		for (int state = 0; state < n; state++)
+			for (int to : graph[state])
+				if (components[to] == components[state])
+					is_nontrivial[components[state]] = true;
+		// reachable[p * n + q]: q достижимо из p
+		vector<char> reachable(static_cast<size_t>(n) * n);
+		for (int from = 0; from < n; from++) {
+			if (!useful[from])
+				continue;
+			char* row = reachable.data() + static_cast<size_t>(from) * n;
+			queue = {from};
+			row[from] = true;
+			for (int i = 0; i < queue.size(); i++)
+				for (int to : graph[queue[i]])
+					if (!row[to]) {
+						row[to] = true;
+						queue.push_back(to);
+					}
+		}
+		auto is_reachable = [&](int from, int to) {
+			return reachable[static_cast<size_t>(from) * n + to] != 0;
+		};
+
+		// тройки A^3 и дуги между ними
+		unordered_map<long long, int> triple_ids;
+		vector<std::tuple<int, int, int>> triples;
+		vector<vector<int>> triple_graph;
+		auto add_triple = [&](int state1, int state2, int state3) {
+			long long key = (static_cast<long long>(state1) * n + state2) * n + state3;
+			auto [it, added] = triple_ids.emplace(key, static_cast<int>(triples.size()));
+			if (added) {
+				triples.emplace_back(state1, state2, state3);
+				triple_graph.emplace_back();
+			}
+			return it->second;
+		};
+		auto find_triple = [&](int state1, int state2, int state3) {
+			long long key = (static_cast<long long>(state1) * n + state2) * n + state3;
+			auto it = triple_ids.find(key);
+			return it == triple_ids.end() ? -1 : it->second;
+		};
+		vector<pair<int, int>> candidates;
+		for (int p = 0; p < n; p++) {
+			if (!useful[p] || !is_nontrivial[components[p]])
+				continue;
+			for (int q = 0; q < n; q++)
+				if (useful[q] && components[q] != components[p] &&
+					is_nontrivial[components[q]] && is_reachable(p, q)) {
+					candidates.emplace_back(p, q);
+					add_triple(p, p, q);
+				}
+		}
+		for (int i = 0; i < triples.size(); i++) {
+			auto [state1, state2, state3] = triples[i];
+			for (int symb_id : symbols)
+				for (int to1 : frozen.get_transitions(state1, symb_id)) {
+					if (components[to1] != components[state1])
+						continue;
+					for (int to2 : frozen.get_transitions(state2, symb_id)) {
+						if (!useful[to2] || !is_reachable(to2, state3))
+							continue;
+						for (int to3 : frozen.get_transitions(state3, symb_id))
+							if (components[to3] == components[state3]) {
+								int to = add_triple(to1, to2, to3);
+								triple_graph[i].push_back(to);
+							}
+					}
+				}
+		}
+		for (auto [p, q] : candidates) {
+			int to = find_triple(p, q, q);
+			if (to != -1)
+				triple_graph[to].push_back(find_triple(p, p, q));
+		}
+		vector<int> triple_components = get_components(triple_graph);
+		for (auto [p, q] : candidates) {
+			int to = find_triple(p, q, q);
+			has_ida |= to != -1 && triple_components[to] == triple_components[find_triple(p, p, q)];
+		}
+	}
+	if (has_eda)
+		return FiniteAutomaton::exponentially_ambiguous;
+	if (has_ida)
+		return FiniteAutomaton::polynomially_ambigious;
+	return FiniteAutomaton::finitely_ambiguous;
+}
+
+namespace {
+void set_ambiguity_result(iLogTemplate* log, FiniteAutomaton::AmbiguityValue result) {
+	switch (result) {
+	case FiniteAutomaton::exponentially_ambiguous:
+		log->set_parameter("result", "Exponentially ambiguous");
+		break;
+	case FiniteAutomaton::almost_unambigious:
+		log->set_parameter("result", "Almost unambigious");
+		break;
+	case FiniteAutomaton::unambigious:
+		log->set_parameter("result", "Unambigious");
+		break;
+	case FiniteAutomaton::polynomially_ambigious:
+		log->set_parameter("result", "Polynomially ambiguous");
+		break;
+	case FiniteAutomaton::finitely_ambiguous:
+		log->set_parameter("result", "Finitely ambiguous");
+		break;
+	default:
+		break;
+	}
+}
+} // namespace
+
 FiniteAutomaton::AmbiguityValue FiniteAutomaton::ambiguity(iLogTemplate* log) const {
 	std::optional<int> word_length;
 	FiniteAutomaton::AmbiguityValue result = get_ambiguity_value(300, word_length);
@@ -1926,22 +2831,16 @@ FiniteAutomaton::AmbiguityValue FiniteAutomaton::ambiguity(iLogTemplate* log) co
 		if (word_length) {
 			log->set_parameter("Для максимальной длины слова", std::to_string(*word_length));
 		}
-		switch (result) {
-		case FiniteAutomaton::exponentially_ambiguous:
-			log->set_parameter("result", "Exponentially ambiguous");
-			break;
-		case FiniteAutomaton::almost_unambigious:
-			log->set_parameter("result", "Almost unambigious");
-			break;
-		case FiniteAutomaton::unambigious:
-			log->set_parameter("result", "Unambigious");
-			break;
-		case FiniteAutomaton::polynomially_ambigious:
-			log->set_parameter("result", "Polynomially ambiguous");
-			break;
-		default:
-			break;
-		}
+		set_ambiguity_result(log, result);
+	}
+	return result;
+}
+
+FiniteAutomaton::AmbiguityValue FiniteAutomaton::structural_ambiguity(iLogTemplate* log) const {
+	FiniteAutomaton::AmbiguityValue result = get_structural_ambiguity_value();
+	if (log) {
+		log->set_parameter("oldautomaton", *this);
+		set_ambiguity_result(log, result);
 	}
 	return result;
 }
@@ -1958,120 +2857,8 @@ TransformationMonoid FiniteAutomaton::get_syntactic_monoid() const {
 	return syntactic_monoid;
 }
 
-void find_maximum_identity_matrix(vector<int>& rows,		   // NOLINT(runtime/references)
-								  vector<vector<bool>>& table, // NOLINT(runtime/references)
-								  int& res,					   // NOLINT(runtime/references)
-								  int size,
-								  vector<pair<int, int>>& result_yx, // NOLINT(runtime/references)
-								  vector<pair<int, int>> temp_result_yx, vector<bool> used_x,
-								  vector<bool> used_y, int unused_x, int unused_y) {
-	auto set_result = [](int& res, // NOLINT(runtime/references)
-						 int size,
-						 vector<pair<int, int>>& result_yx,		   // NOLINT(runtime/references)
-						 vector<pair<int, int>>& temp_result_yx) { // NOLINT(runtime/references)
-		if (size > res) {
-			res = size;
-			result_yx = temp_result_yx;
-		}
-	};
-
-	if (rows.empty()) {
-		set_result(res, size, result_yx, temp_result_yx);
-		return;
-	}
-	int n = table.size(), m = table[0].size();
-	vector<int> y_ind(m, -1);
-	for (int j = 0; j < m; j++) {
-		if (used_x[j])
-			continue;
-		for (int i = 0; i < n; i++) {
-			if (used_y[i])
-				continue;
-			if (!table[i][j])
-				continue;
-			if (y_ind[j] == -1)
-				y_ind[j] = i;
-			else
-				y_ind[j] = -2;
-		}
-	}
-	// отмечаю столбцы с единственной единицей
-	for (int j = 0; j < m; j++) {
-		if (y_ind[j] >= 0) {
-			if (used_y[y_ind[j]])
-				continue;
-			if (used_x[j])
-				continue;
-			used_x[j] = true;
-			used_y[y_ind[j]] = true;
-			unused_y--;
-			unused_x--;
-			size++;
-			temp_result_yx.emplace_back(y_ind[j], j);
-		}
-	}
-	if (unused_y == 0) {
-		set_result(res, size, result_yx, temp_result_yx);
-		return;
-	}
-	unused_y--;
-	for (auto row : rows) {
-		if (used_y[row])
-			continue;
-		used_y[row] = true;
-		// ищу новую 1-цу на каждой строке
-		if (unused_x <= (res - size))
-			return;
-		if (unused_y < (res - size))
-			return;
-		vector<bool> new_used_x = used_x;
-		int new_unused_x = unused_x;
-		vector<int> true_x;
-		for (int i = 0; i < table[row].size(); i++) {
-			if (new_used_x[i])
-				continue;
-			if (!table[row][i])
-				continue;
-			true_x.push_back(i);
-			new_used_x[i] = true;
-			new_unused_x--;
-		}
-		// если нет 1-цы завершаюсь
-		if (true_x.empty()) {
-			set_result(res, size, result_yx, temp_result_yx);
-			used_y[row] = false;
-			continue;
-		}
-		for (int x : true_x) {
-			vector<bool> new_used_y = used_y;
-			int new_unused_y = unused_y;
-			vector<int> false_y;
-			for (int i = 0; i < table.size(); i++) {
-				if (new_used_y[i])
-					continue;
-				false_y.push_back(i);
-			}
-			vector<pair<int, int>> new_result_yx = temp_result_yx;
-			new_result_yx.emplace_back(row, x);
-			vector<bool> temp_used_x = new_used_x;
-			// перехожу на все свободные строки
-			find_maximum_identity_matrix(false_y,
-										 table,
-										 res,
-										 size + 1,
-										 result_yx,
-										 new_result_yx,
-										 temp_used_x,
-										 new_used_y,
-										 new_unused_x,
-										 new_unused_y);
-		}
-		//
-		used_y[row] = false;
-	}
-}
-
-int FiniteAutomaton::get_classes_number_GlaisterShallit(iLogTemplate* log) const {
+int FiniteAutomaton::get_classes_number_GlaisterShallit(
+	iLogTemplate* log, const FoolingSetSearch::Options& options) const {
 	if (log)
 		log->set_parameter("oldautomaton", *this);
 	if (language->is_nfa_minimum_size_cached()) {
@@ -2091,16 +2878,9 @@ int FiniteAutomaton::get_classes_number_GlaisterShallit(iLogTemplate* log) const
 	vector<vector<bool>> equivalence_classes_table =
 		sm.get_equivalence_classes_table(table_rows, table_columns);
 
-	int result = -1;
-	vector<pair<int, int>> result_yx;
-	int m = equivalence_classes_table[0].size(), n = equivalence_classes_table.size();
-	vector<bool> used_x(m);
-	vector<bool> used_y(n);
-	vector<int> rows;
-	for (int i = 0; i < n; i++)
-		rows.push_back(i);
-	find_maximum_identity_matrix(
-		rows, equivalence_classes_table, result, 0, result_yx, {}, used_x, used_y, m, n);
+	FoolingSetSearch::Result search = FoolingSetSearch(equivalence_classes_table).run(options);
+	int result = search.pairs.size();
+	const vector<pair<int, int>>& result_yx = search.pairs;
 
 	// DEBUG
 	// cout << sm.to_txt_MyhillNerode() << endl;
@@ -2137,10 +2917,14 @@ int FiniteAutomaton::get_classes_number_GlaisterShallit(iLogTemplate* log) const
 		}
 		log->set_parameter("result", result);
 		log->set_parameter("table", t);
+		if (!search.complete)
+			log->set_parameter("budget",
+							   "(!) перебор прерван по бюджету, результат - оценка снизу");
 	}
 
-	// кэширование
-	language->set_nfa_minimum_size(result);
+	// кэширование (только точного значения)
+	if (search.complete)
+		language->set_nfa_minimum_size(result);
 	return result;
 }
 
@@ -2325,67 +3109,27 @@ bool FiniteAutomaton::semdet(iLogTemplate* log) const {
 // }
 
 pair<int, bool> FiniteAutomaton::parse(const string& s) const {
-	struct ParingState {
-		int pos;
-		const FAState* state;
-
-		ParingState(int pos, const FAState* state) : pos(pos), state(state) {}
+	static const set<int> no_transitions;
+	// переходы состояния по символу без копирования множества
+	auto get_transitions = [this](int state, const Symbol& symbol) -> const set<int>& {
+		auto transitions = states[state].transitions.find(symbol);
+		return transitions == states[state].transitions.end() ? no_transitions
+															  : transitions->second;
 	};
-	// Пара (актуальный индекс элемента в строке, состояние)
-	stack<ParingState> stack_state;
-	// Тройка (актуальный индекс элемента в строке, начало эпсилон-перехода, конец эпсилон-перехода)
-	set<tuple<int, int, int>> visited_eps;
-	int counter = 0;
-	int parsed_len = 0;
-	const FAState* state = &states[initial_state];
-	stack_state.emplace(parsed_len, state);
-	while (!stack_state.empty()) {
-		if (state->is_terminal && parsed_len == s.size()) {
-			break;
-		}
-		counter++;
-		state = stack_state.top().state;
-		parsed_len = stack_state.top().pos;
-		stack_state.pop();
-		Symbol symb(s[parsed_len]);
-		set<int> trans;
-		if (state->transitions.count(symb))
-			trans = state->transitions.at(symb);
-		// Переходы в новые состояния по очередному символу строки
-		if (parsed_len + 1 <= s.size()) {
-			for (int to : trans) {
-				stack_state.emplace(parsed_len + 1, &states[to]);
-			}
-		}
-
-		// Если произошёл откат по строке, то эпсилон-переходы из рассмотренных состояний больше не
-		// считаются повторными
-		if (!visited_eps.empty()) {
-			set<tuple<int, int, int>> temp_eps;
-			for (auto pos : visited_eps) {
-				if (std::get<0>(pos) <= parsed_len)
-					temp_eps.insert(pos);
-			}
-			visited_eps = temp_eps;
-		}
-		// Добавление тех эпсилон-переходов, по которым ещё не было разбора от этой позиции и этого
-		// состояния
-		set<int> reach_eps;
-		if (state->transitions.count(Symbol::Epsilon))
-			reach_eps = state->transitions.at(Symbol::Epsilon);
-		for (int eps_to : reach_eps) {
-			if (!visited_eps.count({parsed_len, state->index, eps_to})) {
-				stack_state.emplace(parsed_len, &states[eps_to]);
-				visited_eps.insert({parsed_len, state->index, eps_to});
-			}
-		}
-	}
-
-	if (s.size() == parsed_len && state->is_terminal) {
-		return {counter, true};
-	}
+	return parse_with_backtracking(
+		initial_state,
+		s,
+		[this](int state) { return states[state].is_terminal; },
+		[&get_transitions](int state, char c) -> const set<int>& {
+			return get_transitions(state, Symbol(c));
+		},
+		[&get_transitions](int state) -> const set<int>& {
+			return get_transitions(state, Symbol::Epsilon);
+		});
+}
 
-	return {counter, false};
+vector<bool> FiniteAutomaton::parse_batch(const vector<string>& words, int threads_number) const {
+	return FlatDFA(*this).parse_batch(words, threads_number);
 }
 
 bool FiniteAutomaton::is_deterministic(iLogTemplate* log) const {
@@ -2423,6 +3167,15 @@ bool FiniteAutomaton::is_empty() const {
 	return states.empty();
 }
 
+bool FiniteAutomaton::is_universal() const {
+	// автомат, распознающий все слова над алфавитом
+	FAState::Transitions transitions;
+	for (const Symbol& symb : language->get_alphabet())
+		transitions[symb].insert(0);
+	FiniteAutomaton universal(0, {FAState(0, true, transitions)}, language->get_alphabet());
+	return !find_subset_counterexample(universal);
+}
+
 /*
 Джун программист прибегает с проекта к своему ментору и кричит:
 — Меня отпустили с проекта пораньше!
@@ -2453,6 +3206,7 @@ bool FiniteAutomaton::is_finite() const {
 	if (states.empty())
 		return false;
 
+	FrozenAutomaton frozen = freeze();
 	// множество посещённых состояния во время bfs
 	unordered_set<int> visited_states{};
 	// очередь состояний
@@ -2464,7 +3218,7 @@ bool FiniteAutomaton::is_finite() const {
 		state_queue.pop();
 
 		// если рассмотренное состояние - завершающее возвращаем true
-		if (states[actual_state].is_terminal) {
+		if (frozen.is_terminal(actual_state)) {
 			return true;
 		}
 
@@ -2472,12 +3226,10 @@ bool FiniteAutomaton::is_finite() const {
 		visited_states.insert(actual_state);
 
 		// итерируемся по переходам из состояния
-		for (const auto& [_, next_states] : states[actual_state].transitions) {
-			for (int next_state : next_states) {
-				// если состояние не посещено, добавляем его в очередь
-				if (visited_states.count(next_state) == 0) {
-					state_queue.push(next_state);
-				}
+		for (int next_state : frozen.get_transitions(actual_state)) {
+			// если состояние не посещено, добавляем его в очередь
+			if (visited_states.count(next_state) == 0) {
+				state_queue.push(next_state);
 			}
 		}
 	}
@@ -2537,7 +3289,9 @@ Regex FiniteAutomaton::to_regex(iLogTemplate* log) const {
 			for (int state_index_to : states_to) {
 				if (SLAE[state.index].count(state_index_to)) {
 					SLAE[state.index][state_index_to] =
-						Regex(Regex::Type::alt, &SLAE[state.index][state_index_to], &symbol_regex);
+						Regex(Regex::Type::alt,
+							  std::move(SLAE[state.index][state_index_to]),
+							  Regex(symbol_regex));
 				} else {
 					SLAE[state.index].insert({state_index_to, symbol_regex});
 				}
@@ -2558,11 +3312,12 @@ Regex FiniteAutomaton::to_regex(iLogTemplate* log) const {
 		}
 
 		// подготавливаем звёздную регулярку
-		Regex state_self_regex(Regex::Type::star, &SLAE[state_index][state_index]);
+		// (переход в себя удаляется ниже, поэтому его регулярка перемещается)
+		Regex state_self_regex(Regex::Type::star, std::move(SLAE[state_index][state_index]));
 
 		// добавление звёздного перехода к остальным переходам уравнения
 		for (auto& [state_index_to, to_regex] : SLAE[state_index]) {
-			to_regex = Regex(Regex::Type::conc, &state_self_regex, &to_regex);
+			to_regex = Regex(Regex::Type::conc, Regex(state_self_regex), std::move(to_regex));
 		}
 
 		// удаление рассмотренного перехода состояния в себя же
@@ -2600,9 +3355,11 @@ Regex FiniteAutomaton::to_regex(iLogTemplate* log) const {
 				// объединяем полученную регулярку с имеющейся в рассматриваемом уравнении
 				if (equation_from.count(state_index_col)) {
 					equation_from[state_index_col] =
-						Regex(Regex::Type::alt, &equation_from[state_index_col], &regex_from);
+						Regex(Regex::Type::alt,
+							  std::move(equation_from[state_index_col]),
+							  std::move(regex_from));
 				} else {
-					equation_from.insert({state_index_col, regex_from});
+					equation_from.insert({state_index_col, std::move(regex_from)});
 				}
 			}
 
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+// ветвь с AVX2 компилируется для x86-64 всегда и выбирается по процессору при запуске
+#define FLAT_DFA_AVX2
+#endif
+
+#include "Objects/EpsilonClosures.h"
+#include "Objects/FiniteAutomaton.h"
+#include "Objects/FlatDFA.h"
+#include "Objects/SubsetTable.h"
+
+using std::string;
+using std::vector;
+
+namespace {
+// меньшие пакеты не делятся между потоками
+const int MinWordsPerThread = 4096;
+
+#ifdef FLAT_DFA_AVX2
+bool has_avx2() {
+	static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+	return supported;
+}
+
+// состояния шестнадцати слов words[0, 16) после common_length букв: переходы выбираются
+// инструкциями gather, две независимые цепочки по 8 слов скрывают их задержку
+__attribute__((target("avx2"))) void gather_states(const int32_t* byte_classes,
+												   const int32_t* table, int32_t initial,
+												   const string* words, size_t common_length,
+												   int32_t* word_states) {
+	__m256i states0 = _mm256_set1_epi32(initial), states1 = states0;
+	alignas(32) int32_t classes[16];
+	for (size_t position = 0; position < common_length; position++) {
+		for (int k = 0; k < 16; k++)
+			classes[k] = byte_classes[static_cast<unsigned char>(words[k][position])];
+		states0 = _mm256_i32gather_epi32(
+			table,
+			_mm256_add_epi32(states0, _mm256_load_si256(reinterpret_cast<__m256i*>(classes))),
+			4);
+		states1 = _mm256_i32gather_epi32(
+			table,
+			_mm256_add_epi32(states1,
+							 _mm256_load_si256(reinterpret_cast<__m256i*>(classes + 8))),
+			4);
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(word_states), states0);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(word_states + 8), states1);
+}
+#endif
+} // namespace
+
+FlatDFA::FlatDFA(const FiniteAutomaton& fa, int states_limit) {
+	FrozenAutomaton frozen = fa.freeze();
+	std::shared_ptr<const EpsilonClosures> closures = fa.get_epsilon_closures();
+
+	// класс 0 - байты, по которым нет переходов
+	vector<int> class_symbols = {FrozenAutomaton::NoSymbol};
+	for (int c = 0; c < 256; c++) {
+		int symbol_id = frozen.get_char_id(static_cast<char>(c));
+		if (symbol_id == FrozenAutomaton::NoSymbol || symbol_id == frozen.get_epsilon_id()) {
+			byte_classes[c] = 0;
+			continue;
+		}
+		auto it = std::find(class_symbols.begin(), class_symbols.end(), symbol_id);
+		byte_classes[c] = static_cast<int32_t>(it - class_symbols.begin());
+		if (it == class_symbols.end())
+			class_symbols.push_back(symbol_id);
+	}
+	classes_number = static_cast<int>(class_symbols.size());
+
+	// определизация: номер подмножества совпадает с номером состояния
+	SubsetTable subsets;
+	auto add_state = [&](const vector<int>& subset) {
+		auto [index, inserted] = subsets.insert(subset);
+		if (inserted) {
+			accepting.push_back(std::any_of(subset.begin(), subset.end(), [&](int state) {
+				return frozen.is_terminal(state);
+			}));
+			table.resize(table.size() + classes_number);
+		}
+		return index;
+	};
+	initial = add_state(frozen.size() > 0 ? closures->get(frozen.get_initial()) : vector<int>());
+	vector<int> visited(frozen.size(), -1);
+	int stamp = 0;
+	vector<int> subset;
+	for (int index = 0; index < subsets.size() && subsets.size() <= states_limit; index++) {
+		for (int class_id = 0; class_id < classes_number; class_id++) {
+			subset.clear();
+			if (class_id > 0) {
+				for (int state : subsets.get(index))
+					for (int to : frozen.get_transitions(state, class_symbols[class_id]))
+						for (int closure_state : closures->get(to))
+							if (visited[closure_state] != stamp) {
+								visited[closure_state] = stamp;
+								subset.push_back(closure_state);
+							}
+				stamp++;
+				std::sort(subset.begin(), subset.end());
+			}
+			int to = add_state(subset);
+			table[index * classes_number + class_id] = to * classes_number;
+		}
+	}
+	initial *= classes_number;
+	if (subsets.size() > states_limit) {
+		table.clear();
+		accepting.clear();
+		fallback.emplace(fa);
+	}
+}
+
+bool FlatDFA::is_determinized() const {
+	return !fallback;
+}
+
+int FlatDFA::size() const {
+	return static_cast<int>(accepting.size());
+}
+
+bool FlatDFA::parse(const string& s) const {
+	if (fallback)
+		return fallback->parse(s).second;
+	int32_t state = initial;
+	for (char c : s)
+		state = table[state + byte_classes[static_cast<unsigned char>(c)]];
+	return accepting[state / classes_number];
+}
+
+void FlatDFA::parse_range(const vector<string>& words, int first, int last,
+						  vector<char>& results) const { // NOLINT(runtime/references)
+	if (fallback) {
+		for (int i = first; i < last; i++)
+			results[i] = fallback->parse(words[i]).second;
+		return;
+	}
+	// дочитывание слова с позиции position из состояния state
+	auto finish = [&](int32_t state, const string& word, size_t position) {
+		for (; position < word.size(); position++)
+			state = table[state + byte_classes[static_cast<unsigned char>(word[position])]];
+		return accepting[state / classes_number];
+	};
+	int i = first;
+#ifdef FLAT_DFA_AVX2
+	// по 16 слов, если процессор поддерживает AVX2
+	for (; has_avx2() && i + 16 <= last; i += 16) {
+		size_t common_length = words[i].size();
+		for (int k = 1; k < 16; k++)
+			common_length = std::min(common_length, words[i + k].size());
+		int32_t word_states[16];
+		gather_states(byte_classes.data(), table.data(), initial, words.data() + i,
+					  common_length, word_states);
+		for (int k = 0; k < 16; k++)
+			results[i + k] = finish(word_states[k], words[i + k], common_length);
+	}
+#endif
+	// по 4 слова: независимые цепочки чтений таблицы скрывают задержку памяти
+	for (; i + 4 <= last; i += 4) {
+		size_t common_length = std::min(std::min(words[i].size(), words[i + 1].size()),
+										std::min(words[i + 2].size(), words[i + 3].size()));
+		const char* word0 = words[i].data();
+		const char* word1 = words[i + 1].data();
+		const char* word2 = words[i + 2].data();
+		const char* word3 = words[i + 3].data();
+		int32_t state0 = initial, state1 = initial, state2 = initial, state3 = initial;
+		for (size_t position = 0; position < common_length; position++) {
+			state0 = table[state0 + byte_classes[static_cast<unsigned char>(word0[position])]];
+			state1 = table[state1 + byte_classes[static_cast<unsigned char>(word1[position])]];
+			state2 = table[state2 + byte_classes[static_cast<unsigned char>(word2[position])]];
+			state3 = table[state3 + byte_classes[static_cast<unsigned char>(word3[position])]];
+		}
+		results[i] = finish(state0, words[i], common_length);
+		results[i + 1] = finish(state1, words[i + 1], common_length);
+		results[i + 2] = finish(state2, words[i + 2], common_length);
+		results[i + 3] = finish(state3, words[i + 3], common_length);
+	}
+	for (; i < last; i++)
+		results[i] = finish(initial, words[i], 0);
+}
+
+vector<bool> FlatDFA::parse_batch(const vector<string>& words, int threads_number) const {
+	int words_number = static_cast<int>(words.size());
+	if (threads_number <= 0)
+		threads_number = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	threads_number = std::max(1, std::min(threads_number, words_number / MinWordsPerThread));
+
+	// каждый поток пишет в свой отрезок results
+	vector<char> results(words_number);
+	int block_size = (words_number + threads_number - 1) / threads_number;
+	vector<std::thread> threads;
+	for (int t = 1; t < threads_number; t++) {
+		int first = std::min(words_number, t * block_size);
+		int last = std::min(words_number, first + block_size);
+		threads.emplace_back(&FlatDFA::parse_range,
+							 this,
+							 std::cref(words),
+							 first,
+							 last,
+							 std::ref(results));
+	}
+	parse_range(words, 0, std::min(words_number, block_size), results);
+	for (auto& thread : threads)
+		thread.join();
+	return vector<bool>(results.begin(), results.end());
+}
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "Objects/FoolingSetSearch.h"
+#include "Objects/Tools.h"
+
+using std::pair;
+using std::vector;
+
+namespace {
+const int WordBits = 64;
+// после стольких записей таблица пройденных состояний потока очищается
+const size_t MemoLimit = 1 << 20;
+// время проверяется раз в столько узлов
+const int TimeCheckPeriod = 256;
+
+int popcount(uint64_t word) {
+	return static_cast<int>(std::bitset<WordBits>(word).count());
+}
+
+int lowest_bit(uint64_t word) {
+	int bit = 0;
+	while (!(word >> bit & 1))
+		bit++;
+	return bit;
+}
+
+bool test(const vector<uint64_t>& bits, int index) {
+	return bits[index / WordBits] >> (index % WordBits) & 1;
+}
+
+void reset(vector<uint64_t>& bits, int index) { // NOLINT(runtime/references)
+	bits[index / WordBits] &= ~(uint64_t(1) << (index % WordBits));
+}
+
+// число общих единиц bits и words[0, bits.size())
+int common_count(const vector<uint64_t>& bits, const uint64_t* words) {
+	int count = 0;
+	for (int i = 0; i < bits.size(); i++)
+		count += popcount(bits[i] & words[i]);
+	return count;
+}
+
+// номер первой общей единицы bits и words[0, bits.size()) или -1
+int first_common(const vector<uint64_t>& bits, const uint64_t* words) {
+	for (int i = 0; i < bits.size(); i++)
+		if (bits[i] & words[i])
+			return i * WordBits + lowest_bit(bits[i] & words[i]);
+	return -1;
+}
+
+// наибольшее k <= limit, для которого k элементов counts можно расставить на места
+// j = 1..k так, что на месте j стоит число не меньше k - j
+int triangular_bound(vector<int>& counts, int limit) { // NOLINT(runtime/references)
+	std::sort(counts.begin(), counts.end(), std::greater<int>());
+	int bound = 0;
+	int min_sum = limit;
+	for (int j = 1; j <= std::min<int>(limit, counts.size()); j++) {
+		min_sum = std::min(min_sum, counts[j - 1] + j);
+		if (j > min_sum)
+			break;
+		bound = j;
+	}
+	return bound;
+}
+
+void set_all(vector<uint64_t>& bits, int size) { // NOLINT(runtime/references)
+	for (int i = 0; i < size; i++)
+		bits[i / WordBits] |= uint64_t(1) << (i % WordBits);
+}
+} // namespace
+
+// общие для потоков лучший результат и бюджет
+struct SearchState {
+	FoolingSetSearch::Options options;
+	std::chrono::steady_clock::time_point deadline;
+	std::atomic<int> best_size{0};
+	std::atomic<long long> nodes_number{0};
+	std::atomic<bool> stopped{false};
+	std::mutex mutex;
+	vector<pair<int, int>> best_pairs;
+};
+
+class FoolingSetSearch::Searcher {
+  private:
+	const FoolingSetSearch& table;
+	SearchState& state;
+	std::unordered_map<vector<Word>, int, VectorHasher<Word>> memo;
+	int local_nodes = 0;
+
+	const Word* row(int r) const {
+		return table.row_bits.data() + static_cast<size_t>(r) * table.column_words;
+	}
+
+	const Word* column(int c) const {
+		return table.column_bits.data() + static_cast<size_t>(c) * table.row_words;
+	}
+
+	bool out_of_budget() {
+		if (state.stopped.load(std::memory_order_relaxed))
+			return true;
+		long long nodes = state.nodes_number.fetch_add(1, std::memory_order_relaxed) + 1;
+		if (state.options.max_nodes > 0 && nodes > state.options.max_nodes)
+			state.stopped = true;
+		if (state.options.time_limit_ms > 0 && ++local_nodes % TimeCheckPeriod == 0 &&
+			std::chrono::steady_clock::now() > state.deadline)
+			state.stopped = true;
+		return state.stopped;
+	}
+
+	void offer() {
+		int size = path.size() + tail.size();
+		if (size <= state.best_size.load())
+			return;
+		std::lock_guard<std::mutex> lock(state.mutex);
+		if (size <= state.best_size.load())
+			return;
+		state.best_pairs = path;
+		state.best_pairs.insert(state.best_pairs.end(), tail.rbegin(), tail.rend());
+		state.best_size = size;
+	}
+
+	int upper_bound(const vector<Word>& rows, const vector<Word>& columns) const {
+		int rows_number = 0, columns_number = 0;
+		for (Word word : rows)
+			rows_number += popcount(word);
+		for (Word word : columns)
+			columns_number += popcount(word);
+		int bound = std::min(rows_number, columns_number);
+		vector<int> zeros;
+		for (int r = 0; r < table.rows_number; r++)
+			if (test(rows, r))
+				zeros.push_back(columns_number - common_count(columns, row(r)));
+		bound = triangular_bound(zeros, bound);
+		zeros.clear();
+		for (int c = 0; c < table.columns_number; c++)
+			if (test(columns, c))
+				zeros.push_back(rows_number - common_count(rows, column(c)));
+		return triangular_bound(zeros, bound);
+	}
+
+  public:
+	// выбранные пары и пары, отложенные в конец последовательности (в обратном порядке)
+	vector<pair<int, int>> path;
+	vector<pair<int, int>> tail;
+
+	Searcher(const FoolingSetSearch& table, SearchState& state) // NOLINT(runtime/references)
+		: table(table), state(state) {}
+
+	// вычёркивает строки без единиц и столбцы без единиц, выбирает вынужденные пары
+	void reduce(vector<Word>& rows, vector<Word>& columns) { // NOLINT(runtime/references)
+		bool changed = true;
+		while (changed) {
+			changed = false;
+			for (int r = 0; r < table.rows_number; r++) {
+				if (!test(rows, r))
+					continue;
+				int count = common_count(columns, row(r));
+				if (count == 0) {
+					reset(rows, r);
+				} else if (count == 1) {
+					int c = first_common(columns, row(r));
+					path.emplace_back(r, c);
+					reset(rows, r);
+					reset(columns, c);
+					changed = true;
+				}
+			}
+			for (int c = 0; c < table.columns_number; c++) {
+				if (!test(columns, c))
+					continue;
+				int count = common_count(rows, column(c));
+				if (count == 0) {
+					reset(columns, c);
+				} else if (count == 1) {
+					int r = first_common(rows, column(c));
+					tail.emplace_back(r, c);
+					reset(rows, r);
+					reset(columns, c);
+					changed = true;
+				}
+			}
+		}
+	}
+
+	// строки, минимальные по включению единиц в оставшихся столбцах (из равных - первая),
+	// по возрастанию числа единиц
+	vector<int> branch_rows(const vector<Word>& rows, const vector<Word>& columns) const {
+		vector<pair<int, int>> candidates;
+		for (int r = 0; r < table.rows_number; r++)
+			if (test(rows, r))
+				candidates.emplace_back(common_count(columns, row(r)), r);
+		std::sort(candidates.begin(), candidates.end());
+		vector<int> branches;
+		for (auto [count, r] : candidates) {
+			bool dominated = false;
+			for (int kept : branches) {
+				dominated = true;
+				for (int i = 0; i < table.column_words && dominated; i++)
+					if (row(kept)[i] & columns[i] & ~row(r)[i])
+						dominated = false;
+				if (dominated)
+					break;
+			}
+			if (!dominated)
+				branches.push_back(r);
+		}
+		return branches;
+	}
+
+	// выбор строки r: её единицы вычёркиваются из columns
+	void choose(int r, vector<Word>& rows, vector<Word>& columns) { // NOLINT(runtime/references)
+		path.emplace_back(r, first_common(columns, row(r)));
+		reset(rows, r);
+		for (int i = 0; i < table.column_words; i++)
+			columns[i] &= ~row(r)[i];
+	}
+
+	// возвращает false, если состояние отсекается оценкой
+	bool prepare(vector<Word>& rows, vector<Word>& columns) { // NOLINT(runtime/references)
+		reduce(rows, columns);
+		offer();
+		return path.size() + tail.size() + upper_bound(rows, columns) > state.best_size.load();
+	}
+
+	void search(vector<Word> rows, vector<Word> columns) {
+		if (out_of_budget())
+			return;
+		size_t path_size = path.size(), tail_size = tail.size();
+		if (prepare(rows, columns)) {
+			int depth = path.size() + tail.size();
+			vector<Word> key = rows;
+			key.insert(key.end(), columns.begin(), columns.end());
+			auto visited = memo.find(key);
+			// на той же или большей глубине это состояние уже пройдено
+			if (visited == memo.end() || visited->second < depth) {
+				for (int r : branch_rows(rows, columns)) {
+					vector<Word> next_rows = rows, next_columns = columns;
+					choose(r, next_rows, next_columns);
+					search(next_rows, next_columns);
+					path.pop_back();
+					if (state.stopped)
+						break;
+				}
+				if (!state.stopped) {
+					if (memo.size() >= MemoLimit)
+						memo.clear();
+					memo[key] = depth;
+				}
+			}
+		}
+		path.resize(path_size);
+		tail.resize(tail_size);
+	}
+};
+
+FoolingSetSearch::FoolingSetSearch(const vector<vector<bool>>& table)
+	: rows_number(table.size()), columns_number(table.empty() ? 0 : table[0].size()),
+	  row_words((rows_number + WordBits - 1) / WordBits),
+	  column_words((columns_number + WordBits - 1) / WordBits),
+	  row_bits(static_cast<size_t>(rows_number) * column_words),
+	  column_bits(static_cast<size_t>(columns_number) * row_words) {
+	for (int r = 0; r < rows_number; r++)
+		for (int c = 0; c < columns_number; c++)
+			if (table[r][c]) {
+				row_bits[static_cast<size_t>(r) * column_words + c / WordBits] |=
+					Word(1) << (c % WordBits);
+				column_bits[static_cast<size_t>(c) * row_words + r / WordBits] |=
+					Word(1) << (r % WordBits);
+			}
+}
+
+FoolingSetSearch::Result FoolingSetSearch::run(const Options& options) const {
+	SearchState state;
+	state.options = options;
+	state.deadline =
+		std::chrono::steady_clock::now() + std::chrono::milliseconds(options.time_limit_ms);
+	vector<Word> rows(row_words), columns(column_words);
+	set_all(rows, rows_number);
+	set_all(columns, columns_number);
+
+	int threads_number = options.threads_number;
+	if (threads_number <= 0)
+		threads_number = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	Searcher root(*this, state);
+	if (threads_number == 1) {
+		root.search(rows, columns);
+	} else if (root.prepare(rows, columns)) {
+		// ветви первого уровня разбираются потоками по очереди
+		vector<int> branches = root.branch_rows(rows, columns);
+		std::atomic<int> next_branch{0};
+		auto work = [&]() {
+			Searcher worker(*this, state);
+			worker.path = root.path;
+			worker.tail = root.tail;
+			for (int i = next_branch++; i < branches.size() && !state.stopped;
+				 i = next_branch++) {
+				vector<Word> next_rows = rows, next_columns = columns;
+				worker.choose(branches[i], next_rows, next_columns);
+				worker.search(next_rows, next_columns);
+				worker.path.pop_back();
+			}
+		};
+		threads_number = std::min<int>(threads_number, branches.size());
+		vector<std::thread> threads;
+		for (int t = 1; t < threads_number; t++)
+			threads.emplace_back(work);
+		work();
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	Result result;
+	result.pairs = state.best_pairs;
+	result.complete = !state.stopped;
+	result.nodes_number = state.nodes_number;
+	return result;
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <set>
+
+#include "Objects/BacktrackingParser.h"
+#include "Objects/FrozenAutomaton.h"
+#include "Objects/FiniteAutomaton.h"
+#include "Objects/Language.h"
+
+using std::pair;
+using std::set;
+using std::string;
+using std::vector;
+
+FrozenAutomaton::Targets::Targets(const int* first, const int* last) : first(first), last(last) {}
+
+const int* FrozenAutomaton::Targets::begin() const {
+	return first;
+}
+
+const int* FrozenAutomaton::Targets::end() const {
+	return last;
+}
+
+int FrozenAutomaton::Targets::size() const {
+	return static_cast<int>(last - first);
+}
+
+bool FrozenAutomaton::Targets::empty() const {
+	return first == last;
+}
+
+int FrozenAutomaton::Targets::front() const {
+	return *first;
+}
+
+FrozenAutomaton::FrozenAutomaton(const FiniteAutomaton& fa)
+	: initial_state(fa.initial_state), states_number(static_cast<int>(fa.states.size())) {
+	char_ids.fill(NoSymbol);
+	auto add_symbol = [this](const Symbol& symbol) {
+		int id = static_cast<int>(symbols.size());
+		if (symbol_ids.emplace(symbol, id).second) {
+			symbols.push_back(symbol);
+			string str = symbol;
+			if (str.size() == 1)
+				char_ids[static_cast<unsigned char>(str[0])] = id;
+		}
+	};
+
+	if (fa.language)
+		for (const Symbol& symbol : fa.language->get_alphabet())
+			add_symbol(symbol);
+	alphabet_size = static_cast<int>(symbols.size());
+	for (const auto& state : fa.states)
+		for (const auto& [symbol, _] : state.transitions)
+			add_symbol(symbol);
+	if (auto eps = symbol_ids.find(Symbol::Epsilon); eps != symbol_ids.end())
+		epsilon_id = eps->second;
+
+	offsets.assign(states_number + 1, 0);
+	terminal.resize(states_number);
+	for (int i = 0; i < states_number; i++) {
+		terminal[i] = fa.states[i].is_terminal;
+		int transitions_count = 0;
+		for (const auto& [_, states_to] : fa.states[i].transitions)
+			transitions_count += static_cast<int>(states_to.size());
+		offsets[i + 1] = offsets[i] + transitions_count;
+	}
+	labels.resize(offsets.back());
+	targets.resize(offsets.back());
+	// порядок символов в map не совпадает с их номерами в снимке, поэтому строки сортируются
+	vector<pair<int, const set<int>*>> row;
+	for (int i = 0; i < states_number; i++) {
+		row.clear();
+		for (const auto& [symbol, states_to] : fa.states[i].transitions)
+			row.emplace_back(symbol_ids.at(symbol), &states_to);
+		std::sort(row.begin(), row.end());
+		int pos = offsets[i];
+		for (const auto& [symbol_id, states_to] : row)
+			for (int to : *states_to) {
+				labels[pos] = symbol_id;
+				targets[pos++] = to;
+			}
+	}
+}
+
+int FrozenAutomaton::size() const {
+	return states_number;
+}
+
+int FrozenAutomaton::get_initial() const {
+	return initial_state;
+}
+
+bool FrozenAutomaton::is_terminal(int state) const {
+	return terminal[state];
+}
+
+int FrozenAutomaton::symbols_number() const {
+	return static_cast<int>(symbols.size());
+}
+
+int FrozenAutomaton::get_alphabet_size() const {
+	return alphabet_size;
+}
+
+const Symbol& FrozenAutomaton::get_symbol(int symbol_id) const {
+	return symbols[symbol_id];
+}
+
+int FrozenAutomaton::get_symbol_id(const Symbol& symbol) const {
+	auto it = symbol_ids.find(symbol);
+	return it == symbol_ids.end() ? NoSymbol : it->second;
+}
+
+int FrozenAutomaton::get_char_id(char c) const {
+	return char_ids[static_cast<unsigned char>(c)];
+}
+
+int FrozenAutomaton::get_epsilon_id() const {
+	return epsilon_id;
+}
+
+FrozenAutomaton::Targets FrozenAutomaton::get_transitions(int state, int symbol_id) const {
+	if (symbol_id == NoSymbol)
+		return {nullptr, nullptr};
+	const int* first = labels.data() + offsets[state];
+	const int* last = labels.data() + offsets[state + 1];
+	auto [range_first, range_last] = std::equal_range(first, last, symbol_id);
+	return {targets.data() + (range_first - labels.data()),
+			targets.data() + (range_last - labels.data())};
+}
+
+FrozenAutomaton::Targets FrozenAutomaton::get_transitions(int state) const {
+	return {targets.data() + offsets[state], targets.data() + offsets[state + 1]};
+}
+
+int FrozenAutomaton::transitions_number() const {
+	return static_cast<int>(targets.size());
+}
+
+pair<int, bool> FrozenAutomaton::parse(const string& s) const {
+	return parse_with_backtracking(
+		initial_state,
+		s,
+		[this](int state) { return terminal[state] != 0; },
+		[this](int state, char c) { return get_transitions(state, get_char_id(c)); },
+		[this](int state) { return get_transitions(state, epsilon_id); });
+}
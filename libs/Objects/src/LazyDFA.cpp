@@ -0,0 +1,146 @@
+#include <algorithm>
+
+#include "Objects/FiniteAutomaton.h"
+#include "Objects/LazyDFA.h"
+
+using std::string;
+using std::vector;
+
+LazyDFA::LazyDFA(const FiniteAutomaton& fa, int cache_limit, bool unanchored)
+	: frozen(fa.freeze()), closures(fa.get_epsilon_closures()),
+	  symbols_number(frozen.symbols_number()), unanchored(unanchored),
+	  cache_limit(std::max(cache_limit, 1)), visited(frozen.size(), -1) {
+	for (int c = 0; c < 256; c++) {
+		int symbol_id = frozen.get_char_id(static_cast<char>(c));
+		char_ids[c] = symbol_id == FrozenAutomaton::NoSymbol ? other_symbol() : symbol_id;
+	}
+}
+
+int LazyDFA::other_symbol() const {
+	return symbols_number;
+}
+
+int LazyDFA::row_size() const {
+	return symbols_number + 1;
+}
+
+int LazyDFA::add_macrostate() {
+	if (int index = macrostates.find(subset); index != SubsetTable::NotFound)
+		return index;
+	if (macrostates.size() >= cache_limit)
+		flush();
+	int index = macrostates.insert(subset).first;
+	accepting.push_back(std::any_of(
+		subset.begin(), subset.end(), [&](int state) { return frozen.is_terminal(state); }));
+	dead.push_back(subset.empty());
+	transitions.resize(transitions.size() + row_size(), Unknown);
+	return index;
+}
+
+void LazyDFA::flush() {
+	macrostates.clear();
+	accepting.clear();
+	dead.clear();
+	transitions.clear();
+	flushes_number++;
+}
+
+int LazyDFA::get_initial() {
+	subset.clear();
+	if (frozen.size() > 0)
+		subset = closures->get(frozen.get_initial());
+	return add_macrostate();
+}
+
+int LazyDFA::next(int macrostate, char c) {
+	int symbol_id = char_ids[static_cast<unsigned char>(c)];
+	if (int to = transitions[macrostate * row_size() + symbol_id]; to != Unknown)
+		return to;
+	subset.clear();
+	// по буквам, которых нет в автомате, переходов нет
+	if (symbol_id != other_symbol())
+		for (int state : macrostates.get(macrostate))
+			for (int to : frozen.get_transitions(state, symbol_id))
+				for (int closure_state : closures->get(to))
+					if (visited[closure_state] != stamp) {
+						visited[closure_state] = stamp;
+						subset.push_back(closure_state);
+					}
+	if (unanchored && frozen.size() > 0)
+		for (int closure_state : closures->get(frozen.get_initial()))
+			if (visited[closure_state] != stamp) {
+				visited[closure_state] = stamp;
+				subset.push_back(closure_state);
+			}
+	stamp++;
+	std::sort(subset.begin(), subset.end());
+	int flushes = flushes_number;
+	int to = add_macrostate();
+	// после очистки кэша macrostate больше не существует
+	if (flushes == flushes_number)
+		transitions[macrostate * row_size() + symbol_id] = to;
+	return to;
+}
+
+bool LazyDFA::is_accepting(int macrostate) const {
+	return accepting[macrostate];
+}
+
+bool LazyDFA::is_dead(int macrostate) const {
+	return dead[macrostate];
+}
+
+int LazyDFA::run(int macrostate, const char* data, size_t size,
+				 int64_t& accepted_length) { // NOLINT(runtime/references)
+	size_t read_length;
+	return run(macrostate, data, size, accepted_length, read_length);
+}
+
+int LazyDFA::run(int macrostate, const char* data, size_t size,
+				 int64_t& accepted_length, // NOLINT(runtime/references)
+				 size_t& read_length) {	   // NOLINT(runtime/references)
+	int64_t length = accepting[macrostate] ? 0 : -1;
+	read_length = 0;
+	while (read_length < size) {
+		char c = data[read_length++];
+		int symbol_id = char_ids[static_cast<unsigned char>(c)];
+		int to = transitions[macrostate * row_size() + symbol_id];
+		macrostate = to != Unknown ? to : next(macrostate, c);
+		// допустимость макросостояний на случайном входе плохо предсказывается, поэтому
+		// длина обновляется без ветвления
+		int64_t mask = -static_cast<int64_t>(accepting[macrostate] != 0);
+		length += (static_cast<int64_t>(read_length) - length) & mask;
+		if (dead[macrostate])
+			break;
+	}
+	accepted_length = length;
+	return macrostate;
+}
+
+size_t LazyDFA::run_to_accepting(int& macrostate, // NOLINT(runtime/references)
+								 const char* data, size_t size) {
+	int current = macrostate;
+	size_t i = 0;
+	while (i < size && !accepting[current]) {
+		int symbol_id = char_ids[static_cast<unsigned char>(data[i])];
+		int to = transitions[current * row_size() + symbol_id];
+		current = to != Unknown ? to : next(current, data[i]);
+		i++;
+	}
+	macrostate = current;
+	return i;
+}
+
+bool LazyDFA::parse(const string& s) {
+	int64_t accepted_length;
+	run(get_initial(), s.data(), s.size(), accepted_length);
+	return accepted_length == static_cast<int64_t>(s.size());
+}
+
+int LazyDFA::cached_states_number() const {
+	return macrostates.size();
+}
+
+int LazyDFA::get_flushes_number() const {
+	return flushes_number;
+}
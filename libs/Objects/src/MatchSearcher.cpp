@@ -0,0 +1,211 @@
+#include <cstring>
+#include <stdexcept>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+#include "Objects/FiniteAutomaton.h"
+#include "Objects/MatchSearcher.h"
+
+using std::string;
+using std::vector;
+
+namespace {
+const size_t MaxPrefixLength = 64;
+// байты в порядке убывания частоты в текстах и логах; остальные считаются самыми редкими
+const char CommonBytes[] =
+	" 0123456789etaoinsrhldcumfpgwybvkxjqz.,:-/_=\n\tETAOINSRHLDCUMFPGWYBVKXJQZ";
+
+size_t byte_rank(char c) {
+	const char* position = std::strchr(CommonBytes, c);
+	return position && c != '\0' ? position - CommonBytes : sizeof(CommonBytes);
+}
+
+// автомат языка (L \ {ε})^R: начальным становится нефинальная копия начального состояния
+// обращённого автомата без eps-переходов, в которую не ведут переходы
+FiniteAutomaton reverse_nonempty(const FiniteAutomaton& fa) {
+	FiniteAutomaton reversed = fa.reverse().remove_eps();
+	vector<FAState> states = reversed.get_states();
+	int initial = static_cast<int>(states.size());
+	states.emplace_back(initial, "", false, states[reversed.get_initial()].transitions);
+	return FiniteAutomaton(initial, states, reversed.get_language());
+}
+} // namespace
+
+MatchSearcher::MatchSearcher(const FiniteAutomaton& fa)
+	: anchored(fa), unanchored(fa, LazyDFA::DefaultCacheLimit, true),
+	  reversed(reverse_nonempty(fa), LazyDFA::DefaultCacheLimit, true) {
+	// макросостояние якорного ДКА после слова word; номер действителен до следующего вызова
+	// next, поэтому переходы из него вычисляются сразу
+	auto after = [this](const string& word) {
+		int64_t accepted_length;
+		return anchored.run(anchored.get_initial(), word.data(), word.size(), accepted_length);
+	};
+	accepts_empty = anchored.is_accepting(after(""));
+
+	first_bytes.fill(false);
+	for (int c = 0; c < 256; c++)
+		if (!anchored.is_dead(anchored.next(after(""), static_cast<char>(c)))) {
+			first_bytes[c] = true;
+			first_bytes_number++;
+		}
+
+	// префикс продолжается, пока из его макросостояния есть переход лишь по одному байту
+	while (prefix.size() < MaxPrefixLength && !anchored.is_accepting(after(prefix))) {
+		int continuations = 0;
+		char continuation = 0;
+		for (int c = 0; c < 256; c++)
+			if (!anchored.is_dead(anchored.next(after(prefix), static_cast<char>(c)))) {
+				continuations++;
+				continuation = static_cast<char>(c);
+			}
+		if (continuations != 1)
+			break;
+		prefix += continuation;
+	}
+	for (size_t i = 1; i < prefix.size(); i++)
+		if (byte_rank(prefix[i]) > byte_rank(prefix[rare_index]))
+			rare_index = i;
+}
+
+size_t MatchSearcher::skip(const char* data, size_t size, size_t position) const {
+	if (!prefix.empty()) {
+		while (position + prefix.size() <= size) {
+			const void* found = std::memchr(data + position + rare_index,
+											prefix[rare_index],
+											size - position - prefix.size() + 1);
+			if (!found)
+				return size;
+			position = static_cast<const char*>(found) - data - rare_index;
+			if (std::memcmp(data + position, prefix.data(), prefix.size()) == 0)
+				return position;
+			position++;
+		}
+		return size;
+	}
+	if (first_bytes_number == 256)
+		return position;
+	if (first_bytes_number == 0)
+		return size;
+	while (position < size && !first_bytes[static_cast<unsigned char>(data[position])])
+		position++;
+	return position;
+}
+
+void MatchSearcher::mark_starts(const char* data, size_t size, size_t from,
+								vector<bool>& starts) {
+	starts.assign(size - from, false);
+	int macrostate = reversed.get_initial();
+	for (size_t i = size; i > from; i--) {
+		macrostate = reversed.next(macrostate, data[i - 1]);
+		starts[i - 1 - from] = reversed.is_accepting(macrostate);
+	}
+}
+
+vector<MatchSearcher::Match> MatchSearcher::search(const char* data, size_t size) {
+	vector<Match> matches;
+	size_t position = 0;
+	// букв, прочитанных якорными прогонами, не нашедшими вхождения
+	size_t failed_length = 0;
+	// отметки начал вхождений с позиции marked_from: строятся, когда неудачные прогоны
+	// прочитали больше, чем стоит обратный проход по остатку текста
+	vector<bool> starts;
+	size_t marked_from = 0;
+	while ((position = skip(data, size, position)) < size) {
+		if (failed_length > size - position) {
+			if (starts.empty()) {
+				marked_from = position;
+				mark_starts(data, size, marked_from, starts);
+			}
+			while (position < size && !starts[position - marked_from])
+				position++;
+			if (position == size)
+				break;
+			int64_t length;
+			anchored.run(anchored.get_initial(), data + position, size - position, length);
+			matches.emplace_back(position, static_cast<size_t>(length));
+			position += length;
+			continue;
+		}
+		// конец самого раннего вхождения, начинающегося не левее position
+		size_t end = size;
+		if (!accepts_empty) {
+			int macrostate = unanchored.get_initial();
+			end = position +
+				  unanchored.run_to_accepting(macrostate, data + position, size - position);
+			if (!unanchored.is_accepting(macrostate))
+				break;
+		}
+		// самое левое вхождение начинается в [position, end)
+		bool found = false;
+		for (size_t start = position; start < end && failed_length <= size - position;
+			 start = skip(data, size, start + 1)) {
+			int64_t length;
+			size_t read_length;
+			anchored.run(anchored.get_initial(), data + start, size - start, length, read_length);
+			if (length > 0) {
+				matches.emplace_back(start, static_cast<size_t>(length));
+				position = start + length;
+				found = true;
+				break;
+			}
+			failed_length += read_length;
+		}
+		// если неудачные прогоны исчерпали бюджет, начало ищется по отметкам с той же позиции
+		if (!found && failed_length <= size - position)
+			position = end;
+	}
+	return matches;
+}
+
+vector<MatchSearcher::Match> MatchSearcher::search(const string& s) {
+	return search(s.data(), s.size());
+}
+
+vector<MatchSearcher::Match> MatchSearcher::search_file(const string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error("MatchSearcher::search_file: cannot open " + path);
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) < 0) {
+		close(fd);
+		throw std::runtime_error("MatchSearcher::search_file: cannot stat " + path);
+	}
+	size_t size = static_cast<size_t>(file_stat.st_size);
+	if (size == 0) {
+		close(fd);
+		return {};
+	}
+	void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED)
+		throw std::runtime_error("MatchSearcher::search_file: cannot map " + path);
+	madvise(mapped, size, MADV_SEQUENTIAL);
+	vector<Match> matches;
+	try {
+		matches = search(static_cast<const char*>(mapped), size);
+	} catch (...) {
+		munmap(mapped, size);
+		throw;
+	}
+	munmap(mapped, size);
+	return matches;
+#else
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		throw std::runtime_error("MatchSearcher::search_file: cannot open " + path);
+	string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return search(text);
+#endif
+}
+
+const string& MatchSearcher::get_prefix() const {
+	return prefix;
+}
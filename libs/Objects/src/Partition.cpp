@@ -0,0 +1,74 @@
+#include <utility>
+
+#include "Objects/Partition.h"
+
+using std::pair;
+using std::vector;
+
+Partition::Partition(int elements_number)
+	: elements(elements_number), location(elements_number), block_of(elements_number, 0) {
+	for (int i = 0; i < elements_number; i++) {
+		elements[i] = i;
+		location[i] = i;
+	}
+	if (elements_number > 0) {
+		first.push_back(0);
+		mid.push_back(0);
+		last.push_back(elements_number);
+	}
+}
+
+int Partition::size() const {
+	return static_cast<int>(first.size());
+}
+
+int Partition::block(int element) const {
+	return block_of[element];
+}
+
+int Partition::block_size(int block) const {
+	return last[block] - first[block];
+}
+
+const int* Partition::begin(int block) const {
+	return elements.data() + first[block];
+}
+
+const int* Partition::end(int block) const {
+	return elements.data() + last[block];
+}
+
+void Partition::mark(int element) {
+	int b = block_of[element];
+	int position = location[element];
+	if (position < mid[b])
+		return;
+	if (mid[b] == first[b])
+		touched.push_back(b);
+	int other = elements[mid[b]];
+	std::swap(elements[position], elements[mid[b]]);
+	location[other] = position;
+	location[element] = mid[b];
+	mid[b]++;
+}
+
+vector<pair<int, int>> Partition::split() {
+	vector<pair<int, int>> new_blocks;
+	for (int b : touched) {
+		if (mid[b] == last[b]) {
+			// помечен весь блок
+			mid[b] = first[b];
+			continue;
+		}
+		int new_block = size();
+		first.push_back(first[b]);
+		mid.push_back(first[b]);
+		last.push_back(mid[b]);
+		for (int i = first[b]; i < mid[b]; i++)
+			block_of[elements[i]] = new_block;
+		first[b] = mid[b];
+		new_blocks.emplace_back(b, new_block);
+	}
+	touched.clear();
+	return new_blocks;
+}
@@ -1,6 +1,7 @@
 #include <unordered_set>
 
 #include "Objects/BackRefRegex.h"
+#include "Objects/BitParallelMatcher.h"
 #include "Objects/Language.h"
 #include "Objects/Regex.h"
 #include "Objects/iLogTemplate.h"
@@ -35,6 +36,17 @@ Regex::Regex(const string& str, const std::shared_ptr<Language>& new_language) :
 Regex::Regex(Type type, AlgExpression* term_l, AlgExpression* term_r)
 	: AlgExpression(type, term_l, term_r) {}
 
+Regex::Regex(Type type, Regex&& _term_l, Regex&& _term_r) : Regex(type, std::move(_term_l)) {
+	alphabet.insert(_term_r.alphabet.begin(), _term_r.alphabet.end());
+	term_r = new Regex(std::move(_term_r));
+}
+
+Regex::Regex(Type type, Regex&& _term_l) {
+	this->type = type;
+	alphabet = _term_l.alphabet;
+	term_l = new Regex(std::move(_term_l));
+}
+
 Regex& Regex::operator=(const Regex& other) {
 	if (this != &other) {
 		clear();
@@ -74,6 +86,9 @@ template <typename T> Regex* Regex::cast(T* ptr, bool not_null_ptr) {
 	return r;
 }
 
+// используется вне Regex.cpp (RegexDAG)
+template Regex* Regex::cast<AlgExpression>(AlgExpression*, bool);
+
 template <typename T> const Regex* Regex::cast(const T* ptr, bool not_null_ptr) {
 	auto r = dynamic_cast<const Regex*>(ptr);
 	if (!r && not_null_ptr) {
@@ -97,45 +112,6 @@ template <typename T> vector<Regex*> Regex::cast(vector<T*> ptrs, bool not_null_
 	return regexPointers;
 }
 
-Regex* Regex::expr(const vector<AlgExpression::Lexeme>& lexemes, int index_start, int index_end) {
-	AlgExpression* p;
-	p = scan_alt(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_conc(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_star(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_symb(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_eps(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_minus(lexemes, index_start, index_end);
-	if (!p)
-		p = scan_par(lexemes, index_start, index_end);
-	return cast(p, false);
-}
-
-Regex* Regex::scan_minus(const vector<AlgExpression::Lexeme>& lexemes, int index_start,
-						 int index_end) {
-	Regex* p = nullptr;
-
-	if (lexemes[index_start].type != Lexeme::Type::negative) {
-		return nullptr;
-	}
-
-	Regex* l = expr(lexemes, index_start + 1, index_end);
-	if (l == nullptr) {
-		delete l;
-		return nullptr;
-	}
-	p = make();
-	p->term_l = l;
-	p->type = negative;
-
-	p->alphabet = l->alphabet;
-	return p;
-}
-
 vector<FAState> Regex::_to_thompson(const Alphabet& root_alphabet) const {
 	vector<FAState> fa_states; // вектор состояний нового автомата
 	// для формирования поля transitions состояния автомата (структуры State)
@@ -514,6 +490,35 @@ FiniteAutomaton Regex::to_glushkov(iLogTemplate* log) const {
 	return fa;
 }
 
+BitParallelMatcher Regex::compile_bitparallel() const {
+	// позиции и Follow - как в to_glushkov: позиция i + 1 соответствует i-му листу
+	Regex temp_copy(*this);
+	vector<Regex*> terms = temp_copy.preorder_traversal();
+	for (size_t i = 0; i < terms.size(); i++) {
+		terms[i]->symbol.linearize(static_cast<int>(i));
+	}
+	unordered_map<int, vector<int>> following_states = temp_copy.get_follow();
+
+	vector<vector<int>> follow(terms.size() + 1);
+	vector<string> symbols(terms.size() + 1);
+	for (auto& i : temp_copy.get_first_nodes())
+		follow[0].push_back(i->get_symbol().last_linearization_number() + 1);
+	for (const auto& [from, to_positions] : following_states)
+		for (int to : to_positions)
+			follow[from + 1].push_back(to + 1);
+	for (size_t i = 0; i < terms.size(); i++) {
+		Symbol symb = terms[i]->symbol;
+		symb.delinearize();
+		symbols[i + 1] = symb;
+	}
+	vector<int> final_positions;
+	for (auto& i : temp_copy.get_last_nodes())
+		final_positions.push_back(i->get_symbol().last_linearization_number() + 1);
+	if (contains_eps())
+		final_positions.push_back(0);
+	return {follow, symbols, final_positions};
+}
+
 FiniteAutomaton Regex::to_ilieyu(iLogTemplate* log) const {
 	FiniteAutomaton glushkov = this->to_glushkov();
 	vector<FAState> states = glushkov.states;
@@ -768,7 +773,7 @@ bool Regex::partial_derivative_with_respect_to_sym(Regex* respected_sym, const R
 			cur_result.term_l = reg_e->term_l->make_copy();
 		if (reg_e->term_l)
 			cur_result.term_r = reg_e->term_l->make_copy();
-		result.push_back(cur_result);
+		result.push_back(std::move(cur_result));
 		return true;
 	}
 	Regex cur_subresult, cur_subresult1;
@@ -782,37 +787,36 @@ bool Regex::partial_derivative_with_respect_to_sym(Regex* respected_sym, const R
 			return false;
 		}
 		cur_result.type = Type::eps;
-		result.push_back(cur_result);
+		result.push_back(std::move(cur_result));
 		return answer;
 	case Type::alt:
 		answer1 = partial_derivative_with_respect_to_sym(
 			respected_sym, Regex::cast(reg_e->term_l), subresult);
 		answer2 = partial_derivative_with_respect_to_sym(
 			respected_sym, Regex::cast(reg_e->term_r), subresult1);
-		for (const auto& i : subresult) {
-			result.push_back(i);
+		for (auto& i : subresult) {
+			result.push_back(std::move(i));
 		}
-		for (const auto& i : subresult1) {
-			result.push_back(i);
+		for (auto& i : subresult1) {
+			result.push_back(std::move(i));
 		}
 		answer = answer1 | answer2;
 		return answer;
 	case Type::conc:
-		cur_subresult.type = Type::conc;
 		answer1 = partial_derivative_with_respect_to_sym(
 			respected_sym, Regex::cast(reg_e->term_l), subresult);
-		cur_subresult.term_r = reg_e->term_r->make_copy();
+		// производные подвыражения переходят в результат без копирования
 		for (auto& i : subresult) {
-			cur_subresult.term_l = i.make_copy();
-			result.push_back(cur_subresult);
-			delete cur_subresult.term_l;
-			cur_subresult.term_l = nullptr;
+			cur_subresult.type = Type::conc;
+			cur_subresult.term_l = new Regex(std::move(i));
+			cur_subresult.term_r = reg_e->term_r->make_copy();
+			result.push_back(std::move(cur_subresult));
 		}
 		if (Regex::cast(reg_e->term_l)->contains_eps()) {
 			answer2 = partial_derivative_with_respect_to_sym(
 				respected_sym, Regex::cast(reg_e->term_r), subresult1);
-			for (const auto& i : subresult1) {
-				result.push_back(i);
+			for (auto& i : subresult1) {
+				result.push_back(std::move(i));
 			}
 			answer = answer1 | answer2;
 		} else {
@@ -820,15 +824,13 @@ bool Regex::partial_derivative_with_respect_to_sym(Regex* respected_sym, const R
 		}
 		return answer;
 	case Type::star:
-		cur_result.type = Type::conc;
 		answer = partial_derivative_with_respect_to_sym(
 			respected_sym, Regex::cast(reg_e->term_l), subresult);
-		cur_result.term_r = reg_e->make_copy();
 		for (auto& i : subresult) {
-			cur_result.term_l = i.make_copy();
-			result.push_back(cur_result);
-			delete cur_result.term_l;
-			cur_result.term_l = nullptr;
+			cur_result.type = Type::conc;
+			cur_result.term_l = new Regex(std::move(i));
+			cur_result.term_r = reg_e->make_copy();
+			result.push_back(std::move(cur_result));
 		}
 		return answer;
 	case Type::negative:
@@ -858,7 +860,7 @@ bool Regex::partial_derivative_with_respect_to_sym(Regex* respected_sym, const R
 			r_alt.type = Type::negative;
 			r_alt.term_l = new Regex;
 			join_alts(alts, r_alt.term_l);
-			result.push_back(r_alt);
+			result.push_back(std::move(r_alt));
 		}
 
 		return answer;
@@ -1023,80 +1025,65 @@ FiniteAutomaton Regex::to_antimirov(iLogTemplate* log) const {
 	// список состояний в итоговом автомате
 	// собирается в процессе работы алгоритма
 	vector<Regex> fa_states;
+	// строковые записи состояний и их номера,
+	// чтобы не добавлять в fa_states повторяющиеся regex
+	vector<string> name_states;
+	unordered_map<string, int> state_index;
 	// список букв, по которым будут браться частные производные
 	vector<Regex> symbols;
-	// спсиок информации о производных {{regex, производная от r, сивол по которому
-	// дифференцировали}}
-	vector<vector<Regex>> partial_derivatives_by_regex;
-	// мнжество всех частных производных в строковом формате,
-	// чтобы не добавлять в fa_states повторяющиеся regex
-	std::unordered_set<string> check;
+	vector<Symbol> symbol_names;
 	for (const Symbol& as : language->get_alphabet()) {
 		symbols.emplace_back(as);
+		symbol_names.emplace_back(symbols.back().to_txt());
 	}
 
-	fa_states.push_back(*this);
-	check.insert(to_txt());
+	vector<FAState::Transitions> transitions;
+	string deriv_log;
+	auto add_state = [&](Regex&& state, string&& name) {
+		auto [it, inserted] = state_index.insert({name, int(fa_states.size())});
+		if (inserted) {
+			fa_states.push_back(std::move(state));
+			name_states.push_back(std::move(name));
+			transitions.emplace_back();
+		}
+		return it->second;
+	};
+
+	add_state(Regex(*this), to_txt());
 	for (size_t i = 0; i < fa_states.size(); i++) {
 		Regex regex_state = fa_states[i];
-		for (const auto& s : symbols) {
-			// список частных производных от fa_states[i] по символу s
+		for (size_t j = 0; j < symbols.size(); j++) {
+			// список частных производных от fa_states[i] по символу symbols[j]
 			vector<Regex> regs_der;
-			regex_state.partial_symbol_derivative(s, regs_der);
-			for (const auto& reg_der : regs_der) {
-				partial_derivatives_by_regex.push_back({regex_state, reg_der, s});
-				size_t old_checks = check.size();
-				check.insert(reg_der.to_txt());
-				if (old_checks != check.size()) {
-					fa_states.push_back(reg_der);
+			regex_state.partial_symbol_derivative(symbols[j], regs_der);
+			for (auto& reg_der : regs_der) {
+				string name = reg_der.to_txt();
+				if (log) {
+					deriv_log += string(symbol_names[j]) + "(" + name_states[i] + ")" + "\\ =\\ " +
+								 (name.empty() ? "eps" : name) + "\\\\";
 				}
+				int to = add_state(std::move(reg_der), std::move(name));
+				transitions[i][symbol_names[j]].insert(to);
 			}
 		}
 	}
-
-	vector<string> name_states;
-
-	for (auto& state : fa_states) {
-		name_states.push_back(state.to_txt());
+	// журнал производных выводится для каждого состояния
+	if (log) {
+		string single_log = std::move(deriv_log);
+		for (size_t i = 0; i < fa_states.size(); i++)
+			deriv_log += single_log;
 	}
 
 	vector<FAState> automat_state;
-
-	string deriv_log;
-
 	for (size_t i = 0; i < name_states.size(); i++) {
 		string state = name_states[i];
-		FAState::Transitions transit;
-		for (const auto& partial_derivativ : partial_derivatives_by_regex) {
-			// cout << partial_derivativ[0].to_txt() << " ";
-			// cout << partial_derivativ[1].to_txt() << " ";
-			// cout << partial_derivativ[2].to_txt() << endl;
-			deriv_log += partial_derivativ[2].to_txt() + "(" + partial_derivativ[0].to_txt() + ")" +
-						 "\\ =\\ ";
-			if (partial_derivativ[1].to_txt() == "") {
-				deriv_log += "eps\\\\";
-			} else {
-				deriv_log += partial_derivativ[1].to_txt() + "\\\\";
-			}
-
-			if (partial_derivativ[0].to_txt() == state) {
-				// поиск индекс состояния в которое переходим по символу из state
-				auto elem_iter =
-					find(name_states.begin(), name_states.end(), partial_derivativ[1].to_txt());
-				// записываем расстояние между begin и итератором, который указывает на состояние
-				transit[partial_derivativ[2].to_txt()].insert(
-					std::distance(name_states.begin(), elem_iter));
-			}
-		}
-
 		if (state.empty() || fa_states[i].contains_eps()) {
-
 			if (state.empty()) {
 				state = Symbol::Epsilon;
 			}
-			automat_state.emplace_back(int(i), state, true, transit);
+			automat_state.emplace_back(int(i), state, true, transitions[i]);
 		} else {
-			automat_state.emplace_back(int(i), state, false, transit);
+			automat_state.emplace_back(int(i), state, false, transitions[i]);
 		}
 	}
 
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "Objects/Regex.h"
+#include "Objects/RegexDAG.h"
+#include "Objects/Tools.h"
+
+using std::vector;
+
+std::size_t RegexDAG::NodeHasher::operator()(const Node* node) const {
+	std::size_t seed = static_cast<std::size_t>(node->type);
+	hash_combine(seed, node->symbol.get_id());
+	hash_combine(seed, node->term_l ? node->term_l->id : -1);
+	hash_combine(seed, node->term_r ? node->term_r->id : -1);
+	return seed;
+}
+
+bool RegexDAG::NodeEqual::operator()(const Node* a, const Node* b) const {
+	return a->type == b->type && a->symbol == b->symbol && a->term_l == b->term_l &&
+		   a->term_r == b->term_r;
+}
+
+RegexDAG::RegexDAG() {
+	empty_node = intern(Type::empty, Symbol(), nullptr, nullptr);
+	eps_node = intern(Type::eps, Symbol(), nullptr, nullptr);
+}
+
+const RegexDAG::Node* RegexDAG::intern(Type type, const Symbol& symbol, const Node* term_l,
+									   const Node* term_r) {
+	Node key{type, static_cast<int>(nodes.size()), symbol, term_l, term_r, false};
+	auto existing = index.find(&key);
+	if (existing != index.end())
+		return *existing;
+	switch (type) {
+	case Type::eps:
+	case Type::star:
+		key.nullable = true;
+		break;
+	case Type::alt:
+		key.nullable = term_l->nullable || term_r->nullable;
+		break;
+	case Type::conc:
+		key.nullable = term_l->nullable && term_r->nullable;
+		break;
+	case Type::negative:
+		key.nullable = !term_l->nullable;
+		break;
+	default:
+		break;
+	}
+	nodes.push_back(key);
+	index.insert(&nodes.back());
+	return &nodes.back();
+}
+
+void RegexDAG::collect_alts(const Node* node, vector<const Node*>& alts) {
+	while (node->type == Type::alt) {
+		alts.push_back(node->term_l);
+		node = node->term_r;
+	}
+	alts.push_back(node);
+}
+
+const RegexDAG::Node* RegexDAG::empty() const {
+	return empty_node;
+}
+
+const RegexDAG::Node* RegexDAG::eps() const {
+	return eps_node;
+}
+
+const RegexDAG::Node* RegexDAG::symb(const Symbol& symbol) {
+	if (symbol == Symbol::EmptySet)
+		return empty_node;
+	return intern(Type::symb, symbol, nullptr, nullptr);
+}
+
+const RegexDAG::Node* RegexDAG::alt(const Node* term_l, const Node* term_r) {
+	return alt(vector<const Node*>{term_l, term_r});
+}
+
+const RegexDAG::Node* RegexDAG::alt(const vector<const Node*>& terms) {
+	// rule (w1 | w2) | w3 = w1 | (w2 | w3)
+	vector<const Node*> alts;
+	for (const Node* term : terms)
+		collect_alts(term, alts);
+	// rule w1 | w2 = w2 | w1, rule w | w = w
+	std::sort(
+		alts.begin(), alts.end(), [](const Node* a, const Node* b) { return a->id < b->id; });
+	alts.erase(std::unique(alts.begin(), alts.end()), alts.end());
+	bool nullable = std::any_of(alts.begin(), alts.end(), [this](const Node* a) {
+		return a != eps_node && a->nullable;
+	});
+	alts.erase(std::remove_if(alts.begin(),
+							  alts.end(),
+							  [this, nullable](const Node* a) {
+								  return a == empty_node || (nullable && a == eps_node);
+							  }),
+			   alts.end());
+	if (alts.empty())
+		return empty_node;
+	const Node* result = alts.back();
+	for (int i = static_cast<int>(alts.size()) - 2; i >= 0; i--)
+		result = intern(Type::alt, Symbol(), alts[i], result);
+	return result;
+}
+
+const RegexDAG::Node* RegexDAG::conc(const Node* term_l, const Node* term_r) {
+	if (term_l == empty_node || term_r == empty_node)
+		return empty_node;
+	if (term_l == eps_node)
+		return term_r;
+	if (term_r == eps_node)
+		return term_l;
+	// rule (w1 w2) w3 = w1 (w2 w3)
+	if (term_l->type == Type::conc)
+		return conc(term_l->term_l, conc(term_l->term_r, term_r));
+	return intern(Type::conc, Symbol(), term_l, term_r);
+}
+
+const RegexDAG::Node* RegexDAG::star(const Node* term) {
+	if (term == empty_node || term == eps_node)
+		return eps_node;
+	if (term->type == Type::star)
+		return term;
+	return intern(Type::star, Symbol(), term, nullptr);
+}
+
+const RegexDAG::Node* RegexDAG::negative(const Node* term) {
+	if (term->type == Type::negative)
+		return term->term_l;
+	return intern(Type::negative, Symbol(), term, nullptr);
+}
+
+const RegexDAG::Node* RegexDAG::derivative(const Node* node, const Symbol& symbol) {
+	uint64_t key = static_cast<uint64_t>(node->id) << 32 | symbol.get_id();
+	if (auto cached = derivatives.find(key); cached != derivatives.end())
+		return cached->second;
+	const Node* result = empty_node;
+	switch (node->type) {
+	case Type::symb:
+		if (node->symbol == symbol)
+			result = eps_node;
+		break;
+	case Type::alt: {
+		vector<const Node*> alts;
+		collect_alts(node, alts);
+		for (auto& term : alts)
+			term = derivative(term, symbol);
+		result = alt(alts);
+		break;
+	}
+	case Type::conc:
+		result = conc(derivative(node->term_l, symbol), node->term_r);
+		if (node->term_l->nullable)
+			result = alt(result, derivative(node->term_r, symbol));
+		break;
+	case Type::star:
+		result = conc(derivative(node->term_l, symbol), node);
+		break;
+	case Type::negative:
+		result = negative(derivative(node->term_l, symbol));
+		break;
+	default:
+		break;
+	}
+	derivatives[key] = result;
+	return result;
+}
+
+const RegexDAG::Node* RegexDAG::from_regex(const Regex& regex) {
+	switch (regex.type) {
+	case AlgExpression::Type::eps:
+		return eps_node;
+	case AlgExpression::Type::symb:
+		return symb(regex.symbol);
+	case AlgExpression::Type::alt: {
+		// вложенные альтернативы собираются сразу, чтобы не сортировать их на каждом уровне
+		vector<const Regex*> stack = {&regex};
+		vector<const Node*> alts;
+		while (!stack.empty()) {
+			const Regex* term = stack.back();
+			stack.pop_back();
+			if (term->type == AlgExpression::Type::alt) {
+				stack.push_back(Regex::cast(term->term_r));
+				stack.push_back(Regex::cast(term->term_l));
+			} else {
+				alts.push_back(from_regex(*term));
+			}
+		}
+		return alt(alts);
+	}
+	case AlgExpression::Type::conc:
+		return conc(from_regex(*Regex::cast(regex.term_l)),
+					from_regex(*Regex::cast(regex.term_r)));
+	case AlgExpression::Type::star:
+		return star(from_regex(*Regex::cast(regex.term_l)));
+	case AlgExpression::Type::negative:
+		return negative(from_regex(*Regex::cast(regex.term_l)));
+	default:
+		throw std::logic_error("RegexDAG::from_regex: unexpected node type");
+	}
+}
+
+Regex RegexDAG::make_regex(const Node* node) const {
+	Regex result;
+	switch (node->type) {
+	case Type::empty:
+		result.type = AlgExpression::Type::symb;
+		result.symbol = Symbol::EmptySet;
+		return result;
+	case Type::eps:
+		return result;
+	case Type::symb:
+		result.type = AlgExpression::Type::symb;
+		result.symbol = node->symbol;
+		result.alphabet = {node->symbol};
+		return result;
+	case Type::alt:
+		return Regex(AlgExpression::Type::alt, make_regex(node->term_l), make_regex(node->term_r));
+	case Type::conc:
+		return Regex(
+			AlgExpression::Type::conc, make_regex(node->term_l), make_regex(node->term_r));
+	case Type::star:
+		return Regex(AlgExpression::Type::star, make_regex(node->term_l));
+	case Type::negative:
+		return Regex(AlgExpression::Type::negative, make_regex(node->term_l));
+	}
+	return result;
+}
+
+Regex RegexDAG::to_regex(const Node* node, std::shared_ptr<Language> language) const {
+	Regex result = make_regex(node);
+	if (language)
+		result.set_language(language);
+	else
+		result.set_language(result.alphabet);
+	return result;
+}
+
+int RegexDAG::size() const {
+	return nodes.size();
+}
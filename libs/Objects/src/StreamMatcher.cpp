@@ -0,0 +1,32 @@
+#include "Objects/StreamMatcher.h"
+#include "Objects/FiniteAutomaton.h"
+
+StreamMatcher::StreamMatcher(const FiniteAutomaton& fa, int cache_limit) : dfa(fa, cache_limit) {
+	reset();
+}
+
+void StreamMatcher::feed(const char* data, size_t size) {
+	int64_t accepted_length;
+	macrostate = dfa.run(macrostate, data, size, accepted_length);
+	if (accepted_length > 0)
+		longest_accepted_prefix = position + accepted_length;
+	position += static_cast<int64_t>(size);
+}
+
+bool StreamMatcher::is_accepting() const {
+	return dfa.is_accepting(macrostate);
+}
+
+int64_t StreamMatcher::get_position() const {
+	return position;
+}
+
+int64_t StreamMatcher::get_longest_accepted_prefix() const {
+	return longest_accepted_prefix;
+}
+
+void StreamMatcher::reset() {
+	macrostate = dfa.get_initial();
+	position = 0;
+	longest_accepted_prefix = dfa.is_accepting(macrostate) ? 0 : -1;
+}
@@ -0,0 +1,95 @@
+#include "Objects/SubsetTable.h"
+#include "Objects/Tools.h"
+
+using std::pair;
+using std::vector;
+
+SubsetTable::Subset::Subset(const int* first, const int* last) : first(first), last(last) {}
+
+const int* SubsetTable::Subset::begin() const {
+	return first;
+}
+
+const int* SubsetTable::Subset::end() const {
+	return last;
+}
+
+int SubsetTable::Subset::size() const {
+	return static_cast<int>(last - first);
+}
+
+SubsetTable::SubsetTable() : slots(16, NotFound) {}
+
+size_t SubsetTable::hash(const vector<int>& subset) {
+	size_t seed = subset.size();
+	for (int i : subset)
+		hash_combine(seed, i);
+	return seed;
+}
+
+bool SubsetTable::equal(int index, const vector<int>& subset) const {
+	int start = starts[index];
+	if (starts[index + 1] - start != static_cast<int>(subset.size()))
+		return false;
+	for (size_t i = 0; i < subset.size(); i++)
+		if (elements[start + i] != subset[i])
+			return false;
+	return true;
+}
+
+size_t SubsetTable::find_slot(const vector<int>& subset, size_t hash) const {
+	size_t mask = slots.size() - 1;
+	size_t slot = hash & mask;
+	// линейное пробирование, таблица заполнена не более чем наполовину
+	while (slots[slot] != NotFound &&
+		   (hashes[slots[slot]] != hash || !equal(slots[slot], subset)))
+		slot = (slot + 1) & mask;
+	return slot;
+}
+
+void SubsetTable::grow() {
+	vector<int> new_slots(slots.size() * 2, NotFound);
+	size_t mask = new_slots.size() - 1;
+	for (int index = 0; index < size(); index++) {
+		size_t slot = hashes[index] & mask;
+		while (new_slots[slot] != NotFound)
+			slot = (slot + 1) & mask;
+		new_slots[slot] = index;
+	}
+	slots.swap(new_slots);
+}
+
+int SubsetTable::find(const vector<int>& subset) const {
+	return slots[find_slot(subset, hash(subset))];
+}
+
+pair<int, bool> SubsetTable::insert(const vector<int>& subset) {
+	size_t subset_hash = hash(subset);
+	size_t slot = find_slot(subset, subset_hash);
+	if (slots[slot] != NotFound)
+		return {slots[slot], false};
+
+	int index = size();
+	elements.insert(elements.end(), subset.begin(), subset.end());
+	starts.push_back(static_cast<int>(elements.size()));
+	hashes.push_back(subset_hash);
+	slots[slot] = index;
+	if (2 * size() > static_cast<int>(slots.size()))
+		grow();
+	return {index, true};
+}
+
+SubsetTable::Subset SubsetTable::get(int index) const {
+	return {elements.data() + starts[index], elements.data() + starts[index + 1]};
+}
+
+int SubsetTable::size() const {
+	return static_cast<int>(hashes.size());
+}
+
+void SubsetTable::clear() {
+	elements.clear();
+	starts.assign(1, 0);
+	hashes.clear();
+	slots.assign(slots.size(), NotFound);
+}
@@ -1,80 +1,137 @@
-#include <sstream>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
 
 #include "Objects/Symbol.h"
+#include "Objects/Tools.h"
 
 using std::cout;
+using std::optional;
 using std::string;
 using std::to_string;
 using std::vector;
 
-Symbol::Symbol(const string& s) : symbol(s), value(s) {}
-Symbol::Symbol(const char* c) : symbol(c), value(c) {}
-Symbol::Symbol(char c) : symbol(string(1, c)), value(string(1, c)) {}
+const Symbol::Data* Symbol::intern(string symbol, vector<int> annote_numbers,
+								   vector<int> linearize_numbers, optional<int> reference) {
+	struct DataHasher {
+		size_t operator()(const Data* d) const {
+			size_t seed = std::hash<string>{}(d->symbol);
+			for (int i : d->annote_numbers)
+				hash_combine(seed, i);
+			hash_combine(seed, -1);
+			for (int i : d->linearize_numbers)
+				hash_combine(seed, i);
+			hash_combine(seed, d->reference.value_or(-1));
+			return seed;
+		}
+	};
+	struct DataEqual {
+		bool operator()(const Data* a, const Data* b) const {
+			return a->symbol == b->symbol && a->annote_numbers == b->annote_numbers &&
+				   a->linearize_numbers == b->linearize_numbers && a->reference == b->reference;
+		}
+	};
+	// deque не перемещает элементы при добавлении, указатели на записи остаются валидными
+	static std::mutex table_mutex;
+	static std::deque<Data> entries;
+	static std::unordered_set<const Data*, DataHasher, DataEqual> index;
+
+	Data key{std::move(symbol),
+			 std::move(annote_numbers),
+			 std::move(linearize_numbers),
+			 reference,
+			 string(),
+			 0};
+	std::lock_guard<std::mutex> lock(table_mutex);
+	if (auto it = index.find(&key); it != index.end())
+		return *it;
+
+	if (key.reference.has_value())
+		key.value = '&';
+	key.value += key.symbol;
+	for (const auto& i : key.annote_numbers)
+		key.value += annote_marker + to_string(i);
+	for (const auto& i : key.linearize_numbers)
+		key.value += linearize_marker + to_string(i);
+	key.id = static_cast<uint32_t>(entries.size());
+	entries.push_back(std::move(key));
+	index.insert(&entries.back());
+	return &entries.back();
+}
+
+const Symbol::Data* Symbol::intern(char c) {
+	// однобуквенные символы создаются чаще всего (разбор слов), поэтому они предвычислены
+	static const std::array<const Data*, 256> chars = []() {
+		std::array<const Data*, 256> res{};
+		for (int i = 0; i < 256; i++)
+			res[i] = intern(string(1, static_cast<char>(i)), {}, {}, std::nullopt);
+		return res;
+	}();
+	return chars[static_cast<unsigned char>(c)];
+}
+
+Symbol::Symbol(const Data* data) : data(data) {}
+
+Symbol::Symbol() {
+	static const Data* empty = intern("", {}, {}, std::nullopt);
+	data = empty;
+}
+
+Symbol::Symbol(const string& s)
+	: data(s.size() == 1 ? intern(s[0]) : intern(s, {}, {}, std::nullopt)) {}
+Symbol::Symbol(const char* c) : Symbol(string(c)) {}
+Symbol::Symbol(char c) : data(intern(c)) {}
 
 Symbol Symbol::Ref(int number) {
-	Symbol s;
-	s.reference = number;
-	s.symbol = to_string(number);
-	s.value = '&' + s.symbol;
-	return s;
-}
-
-void Symbol::update_value() {
-	std::stringstream ss;
-	if (reference.has_value())
-		ss << '&';
-	ss << symbol;
-
-	for (const auto& i : annote_numbers)
-		ss << annote_marker << i;
-
-	for (const auto& i : linearize_numbers)
-		ss << linearize_marker << i;
-
-	value = ss.str();
+	return Symbol(intern(to_string(number), {}, {}, number));
 }
 
 Symbol& Symbol::operator=(const string& s) {
-	symbol = s;
-	value = symbol;
-	return *this;
+	return *this = Symbol(s);
 }
 
 Symbol& Symbol::operator=(const char* c) {
-	symbol = c;
-	value = symbol;
-	return *this;
+	return *this = Symbol(c);
 }
 
 Symbol& Symbol::operator=(char c) {
-	symbol = c;
-	value = symbol;
+	data = intern(c);
 	return *this;
 }
 
+uint32_t Symbol::get_id() const {
+	return data->id;
+}
+
 bool Symbol::is_epsilon() const {
-	return *this == Symbol::Epsilon;
+	static const Data* epsilon = intern(Symbol::Epsilon, {}, {}, std::nullopt);
+	return data == epsilon;
 }
 
 bool Symbol::operator==(const Symbol& other) const {
-	return symbol == other.symbol && annote_numbers == other.annote_numbers &&
-		   linearize_numbers == other.linearize_numbers;
+	return data == other.data;
 }
 
 bool Symbol::operator==(char c) const {
-	return symbol.size() == 1 && symbol[0] == c;
+	return data->symbol.size() == 1 && data->symbol[0] == c;
 }
 
 bool Symbol::operator!=(const Symbol& other) const {
 	return !(*this == other);
 }
 
+// порядок остаётся лексикографическим по value, чтобы порядок обхода алфавитов и переходов
+// (а значит, и нумерация состояний в алгоритмах) не зависел от порядка интернирования
 bool Symbol::operator<(const Symbol& other) const {
-	return value < other.value;
+	if (data == other.data)
+		return false;
+	int cmp = data->value.compare(other.data->value);
+	return cmp != 0 ? cmp < 0 : data->id < other.data->id;
 }
 
 Symbol::operator string() const {
-	return value;
+	return data->value;
 }
 
 string Symbol::vector_to_str(const vector<Symbol>& in) {
@@ -89,56 +146,58 @@ std::ostream& operator<<(std::ostream& os, const Symbol& as) {
 }
 
 void Symbol::annote(int num) {
+	vector<int> annote_numbers = data->annote_numbers;
 	annote_numbers.push_back(num);
-	update_value();
+	data = intern(data->symbol, annote_numbers, data->linearize_numbers, data->reference);
 }
 
 void Symbol::linearize(int num) {
+	vector<int> linearize_numbers = data->linearize_numbers;
 	linearize_numbers.push_back(num);
-	update_value();
+	data = intern(data->symbol, data->annote_numbers, linearize_numbers, data->reference);
 }
 
 void Symbol::deannote() {
-	if (!annote_numbers.empty()) {
+	if (!data->annote_numbers.empty()) {
+		vector<int> annote_numbers = data->annote_numbers;
 		annote_numbers.pop_back();
-		update_value();
+		data = intern(data->symbol, annote_numbers, data->linearize_numbers, data->reference);
 	}
 }
 
 void Symbol::delinearize() {
-	if (!linearize_numbers.empty()) {
+	if (!data->linearize_numbers.empty()) {
+		vector<int> linearize_numbers = data->linearize_numbers;
 		linearize_numbers.pop_back();
-		update_value();
+		data = intern(data->symbol, data->annote_numbers, linearize_numbers, data->reference);
 	}
 }
 
 bool Symbol::is_annotated() const {
-	return !annote_numbers.empty();
+	return !data->annote_numbers.empty();
 }
 
 bool Symbol::is_linearized() const {
-	return !linearize_numbers.empty();
+	return !data->linearize_numbers.empty();
 }
 
 bool Symbol::is_ref() const {
-	return reference.has_value();
+	return data->reference.has_value();
 }
 
 int Symbol::get_ref() const {
-	return reference.value();
+	return data->reference.value();
 }
 
 int Symbol::last_linearization_number() const {
-	if (!linearize_numbers.empty())
-		return linearize_numbers.back();
+	if (!data->linearize_numbers.empty())
+		return data->linearize_numbers.back();
 	else
 		return 0;
 }
 
 std::size_t Symbol::Hasher::operator()(const Symbol& s) const {
-	std::hash<string> string_hash;
-	std::size_t hash = string_hash(s.value);
-	return hash;
+	return s.data->id;
 }
 
 Symbol MemorySymbols::Close(int number) {
@@ -154,8 +213,9 @@ Symbol MemorySymbols::Open(int number) {
 }
 
 bool MemorySymbols::is_memory_symbol(const Symbol& s) {
-	return s.symbol.size() > 1 &&
-		   (s.symbol[0] == CloseChar || s.symbol[0] == ResetChar || s.symbol[0] == OpenChar);
+	const string& symbol = s.data->symbol;
+	return symbol.size() > 1 &&
+		   (symbol[0] == CloseChar || symbol[0] == ResetChar || symbol[0] == OpenChar);
 }
 
 bool MemorySymbols::is_memory_char(char c) {
@@ -163,19 +223,19 @@ bool MemorySymbols::is_memory_char(char c) {
 }
 
 bool MemorySymbols::is_close(const Symbol& s) {
-	return s.symbol.size() > 1 && s.symbol[0] == CloseChar;
+	return s.data->symbol.size() > 1 && s.data->symbol[0] == CloseChar;
 }
 
 bool MemorySymbols::is_reset(const Symbol& s) {
-	return s.symbol.size() > 1 && s.symbol[0] == ResetChar;
+	return s.data->symbol.size() > 1 && s.data->symbol[0] == ResetChar;
 }
 
 bool MemorySymbols::is_open(const Symbol& s) {
-	return s.symbol.size() > 1 && s.symbol[0] == OpenChar;
+	return s.data->symbol.size() > 1 && s.data->symbol[0] == OpenChar;
 }
 
 int MemorySymbols::get_cell_number(const Symbol& s) {
-	string number_str = s.symbol.substr(1);
+	string number_str = s.data->symbol.substr(1);
 	if (number_str.empty()) {
 		return 0;
 	}
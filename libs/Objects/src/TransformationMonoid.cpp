@@ -1,7 +1,11 @@
 #include <algorithm>
 #include <iostream>
+#include <limits>
+#include <unordered_set>
 
+#include "Objects/AhoCorasick.h"
 #include "Objects/Language.h"
+#include "Objects/Tools.h"
 
 using std::cout;
 using std::map;
@@ -49,40 +53,155 @@ TransformationMonoid::TransformationMonoid(const FiniteAutomaton& in) {
 	}
 
 	automaton = FA_model(temp_fa.get_initial(), temp_fa.get_states(), temp_fa.get_language());
-
-	// cout << automaton.to_txt();
-	vector<TransformationMonoid::Transition>
-		init_transitions; // получаем состояния по eps переходу (из себя в себя)
-	for (int i = 0; i < automaton.get_states().size(); i++) {
-		TransformationMonoid::Transition temp;
-		temp.first = i;
-		temp.second = i;
-		init_transitions.push_back(temp);
+	const Alphabet& symbols = automaton.get_language()->get_alphabet();
+	alphabet.assign(symbols.begin(), symbols.end());
+	states_number = automaton.get_states().size();
+	// образ пустого слова: q -> {q}
+	vector<int> identity(states_number);
+	for (int state = 0; state < states_number; state++)
+		identity[state] = add_subset({state});
+
+	// термы с одинаковыми образами ищутся по хешу образа
+	auto image_hash = [this](int term) {
+		size_t seed = states_number;
+		for (int state = 0; state < states_number; state++)
+			hash_combine(seed, get_image(term, state));
+		return seed;
+	};
+	auto image_equal = [this](int a, int b) {
+		for (int state = 0; state < states_number; state++)
+			if (get_image(a, state) != get_image(b, state))
+				return false;
+		return true;
+	};
+	std::unordered_set<int, decltype(image_hash), decltype(image_equal)> known_images(
+		16, image_hash, image_equal);
+
+	// левые части правил переписывания (в номерах букв): кандидат, содержащий одну из них,
+	// переписывается
+	AhoCorasick rewritable(alphabet.size());
+	// кандидаты в термы в порядке обхода в ширину: (родитель, буква), -1 - пустое слово
+	std::queue<std::pair<int, int>> candidates;
+	for (int symbol = 0; symbol < alphabet.size(); symbol++)
+		candidates.emplace(-1, symbol);
+	while (!candidates.empty()) { // пока есть кандидаты
+		auto [parent, symbol] = candidates.front();
+		candidates.pop();
+		vector<int> word = parent == -1 ? vector<int>() : get_word(parent);
+		word.push_back(symbol);
+		if (rewritable.contains_match(word)) // если переписывается
+			continue;
+		// образ кандидата временно дописывается в конец images
+		int candidate = terms.size();
+		for (int state = 0; state < states_number; state++) {
+			int from = parent == -1 ? identity[state] : get_image(parent, state);
+			push_image(get_next_subset(from, symbol));
+		}
+		auto rewrite_in = known_images.find(candidate);
+		if (rewrite_in != known_images.end()) { // в правила переписывания
+			pop_image();
+			vector<Symbol> name;
+			for (int letter : word)
+				name.push_back(alphabet[letter]);
+			rules[get_name(*rewrite_in)].push_back(name);
+			rewritable.add(word);
+			continue;
+		}
+		// новый терм
+		Term term;
+		term.parent = parent;
+		term.symbol = symbol;
+		term.length = word.size();
+		term.isFinal = final_subsets[get_image(candidate, automaton.get_initial_state())];
+		terms.push_back(term);
+		known_images.insert(candidate);
+		for (int next_symbol = 0; next_symbol < alphabet.size(); next_symbol++)
+			candidates.emplace(candidate, next_symbol);
 	}
-	get_new_transition(init_transitions, {}, automaton.get_language()->get_alphabet());
-	while (!queueTerm.empty()) { // пока есть кандидаты
-		TransformationMonoid::Term cur = queueTerm.front();
-		queueTerm.pop();
-		if (!searchrewrite(cur.name)) { // если не переписывается
-			auto rewrite_in = std::find(terms.begin(), terms.end(), cur);
-
-			if (rewrite_in != terms.end()) { // в правила переписывания
-				rules[rewrite_in->name].push_back(cur.name);
-			} else { // новый терм
-				for (const auto& transition : cur.transitions) {
-					if (automaton.get_states()[transition.second].is_terminal &&
-						transition.first == automaton.get_initial_state()) {
-						cur.isFinal = true;
-						break;
-					}
-				}
+}
 
-				terms.push_back(cur);
-				get_new_transition(
-					cur.transitions, cur.name, automaton.get_language()->get_alphabet());
-			}
-		}
-	}
+int TransformationMonoid::get_image(int term, int state) const {
+	size_t index = static_cast<size_t>(term) * states_number + state;
+	return wide ? wide_images[index] : images[index];
+}
+
+void TransformationMonoid::push_image(int subset) {
+	if (wide)
+		wide_images.push_back(subset);
+	else
+		images.push_back(subset);
+}
+
+void TransformationMonoid::pop_image() {
+	if (wide)
+		wide_images.resize(wide_images.size() - states_number);
+	else
+		images.resize(images.size() - states_number);
+}
+
+int TransformationMonoid::add_subset(const vector<int>& subset) {
+	auto [index, added] = subsets.insert(subset);
+	if (added) {
+		if (!wide && index > std::numeric_limits<Image>::max()) {
+			// номер не помещается в 16 бит: образы переводятся в 32 бита
+			wide_images.assign(images.begin(), images.end());
+			images = vector<Image>();
+			wide = true;
+		}
+		bool is_final = false;
+		for (int state : subset)
+			is_final |= automaton.get_states()[state].is_terminal;
+		final_subsets.push_back(is_final);
+		subset_transitions.resize(subset_transitions.size() + alphabet.size(), Unknown);
+	}
+	return index;
+}
+
+int TransformationMonoid::get_next_subset(int subset, int symbol) {
+	size_t cell = static_cast<size_t>(subset) * alphabet.size() + symbol;
+	if (subset_transitions[cell] != Unknown)
+		return subset_transitions[cell];
+	set<int> next;
+	for (int state : subsets.get(subset)) {
+		const auto& transitions = automaton.get_states()[state].transitions;
+		auto by_symbol = transitions.find(alphabet[symbol]);
+		if (by_symbol != transitions.end())
+			next.insert(by_symbol->second.begin(), by_symbol->second.end());
+	}
+	int next_subset = add_subset(vector<int>(next.begin(), next.end()));
+	subset_transitions[cell] = next_subset;
+	return next_subset;
+}
+
+vector<int> TransformationMonoid::get_word(int term) const {
+	vector<int> word(terms[term].length);
+	for (int i = word.size() - 1; i >= 0; i--, term = terms[term].parent)
+		word[i] = terms[term].symbol;
+	return word;
+}
+
+vector<Symbol> TransformationMonoid::get_name(int term) const {
+	vector<Symbol> name;
+	for (int symbol : get_word(term))
+		name.push_back(alphabet[symbol]);
+	return name;
+}
+
+int TransformationMonoid::count_final_pairs(const vector<int>& sequence) const {
+	vector<char> current(states_number), next(states_number);
+	current[automaton.get_initial_state()] = true;
+	for (int term : sequence) {
+		std::fill(next.begin(), next.end(), false);
+		for (int state = 0; state < states_number; state++)
+			if (current[state])
+				for (int to : subsets.get(get_image(term, state)))
+					next[to] = true;
+		current.swap(next);
+	}
+	int pairs = 0;
+	for (int state = 0; state < states_number; state++)
+		pairs += current[state] && automaton.get_states()[state].is_terminal;
+	return pairs;
 }
 
 vector<Symbol> union_words(vector<Symbol> a, vector<Symbol> b) {
@@ -162,61 +281,6 @@ vector<vector<Symbol>> get_comb_alphabet(int len, const set<Symbol>& alphabet) {
 //	return in;
 // }
 
-bool TransformationMonoid::was_rewrite(const vector<Symbol>& a, const vector<Symbol>& b) {
-	for (int i = 0; i < a.size(); i++) {
-		for (int j = 0; i + j < a.size() && j < b.size(); j++) {
-			if (b[j] != a[i + j]) {
-				break;
-			}
-			if (j == b.size() - 1) {
-				return true;
-			}
-		}
-	}
-	return false;
-}
-
-bool TransformationMonoid::searchrewrite(const vector<Symbol>& in) {
-	for (const auto& currules : rules) {
-		for (const vector<Symbol>& rule : currules.second) {
-			if (was_rewrite(in, rule)) {
-				return true;
-			}
-		}
-	}
-	return false;
-}
-
-void TransformationMonoid::get_new_transition(const vector<TransformationMonoid::Transition>& in,
-											  const vector<Symbol>& word,
-											  const set<Symbol>& alphabet) {
-	for (const Symbol& as : alphabet) { // для каждого символа
-		set<TransformationMonoid::Transition> out;
-		for (const TransformationMonoid::Transition& temp : in) {
-			if (!automaton.get_states()[temp.second].transitions.count(as))
-				continue;
-			set<int> tostate =
-				automaton.get_states()[temp.second].transitions.at(as); // получаем все переходы
-			for (int outstate : tostate) { // для каждого перехода
-				TransformationMonoid::Transition curtransition;
-				curtransition.first = temp.first;
-				curtransition.second = outstate;
-				out.insert(curtransition);
-			}
-		}
-		// получили новые переходы
-		Term curTerm;
-		vector<TransformationMonoid::Transition> v(out.size());
-		std::copy(out.begin(), out.end(), v.begin());
-		curTerm.transitions = v;
-		vector<Symbol> tempword = word;
-		tempword.push_back(as);
-		curTerm.name = tempword;
-		queueTerm.push(curTerm);
-	}
-}
-
-
 string TransformationMonoid::to_txt() {
 	stringstream ss;
 	ss << "Equivalence classes:\n";
@@ -225,25 +289,25 @@ string TransformationMonoid::to_txt() {
 	ss << get_rewriting_rules_txt();
 	ss << "Information for class w:\n";
 
-	for (auto& term : terms) {
-		ss << "  class " << Symbol::vector_to_str(term.name) << "\n";
-		vector<TransformationMonoid::Term> vw = get_equalence_classes_vw(term);
+	for (int term = 0; term < terms.size(); term++) {
+		ss << "  class " << Symbol::vector_to_str(get_name(term)) << "\n";
+		vector<int> vw = get_equalence_classes_vw(term);
 		ss << "\t equivalence classes v such that  accepts vw: ";
-		for (const TransformationMonoid::Term& CurTerm : vw) {
-			ss << Symbol::vector_to_str(CurTerm.name) << ", ";
+		for (int cur_term : vw) {
+			ss << Symbol::vector_to_str(get_name(cur_term)) << ", ";
 		}
 		ss << "\n";
-		vector<TransformationMonoid::Term> wv = get_equalence_classes_wv(term);
+		vector<int> wv = get_equalence_classes_wv(term);
 		ss << "\t equivalence classes v such that  accepts wv: ";
-		for (const TransformationMonoid::Term& CurTerm : wv) {
-			ss << Symbol::vector_to_str(CurTerm.name) << ", ";
+		for (int cur_term : wv) {
+			ss << Symbol::vector_to_str(get_name(cur_term)) << ", ";
 		}
 		ss << "\n";
-		vector<TransformationMonoid::TermDouble> vwv = get_equalence_classes_vwv(term);
+		vector<std::pair<int, int>> vwv = get_equalence_classes_vwv(term);
 		ss << "\t equivalence classes v such that  accepts wv: ";
-		for (const TransformationMonoid::TermDouble& CurTerm : vwv) {
-			ss << Symbol::vector_to_str(CurTerm.first.name) << " - "
-			   << Symbol::vector_to_str(CurTerm.second.name) << ", ";
+		for (const auto& [first, second] : vwv) {
+			ss << Symbol::vector_to_str(get_name(first)) << " - "
+			   << Symbol::vector_to_str(get_name(second)) << ", ";
 		}
 		ss << "\n";
 		int sync = is_synchronized(term);
@@ -268,12 +332,14 @@ map<vector<Symbol>, vector<vector<Symbol>>> TransformationMonoid::get_rewriting_
 
 string TransformationMonoid::get_equalence_classes_txt() {
 	stringstream ss;
-	for (auto& term : terms) {
-		ss << "Term	" << Symbol::vector_to_str(term.name) << "	in	language	" << term.isFinal
-		   << "\n";
-		for (int j = 0; j < term.transitions.size(); j++) {
-			ss << automaton.get_states()[term.transitions[j].first].identifier << "	->	"
-			   << automaton.get_states()[term.transitions[j].second].identifier << "\n";
+	for (int term = 0; term < terms.size(); term++) {
+		ss << "Term	" << Symbol::vector_to_str(get_name(term)) << "	in	language	"
+		   << terms[term].isFinal << "\n";
+		for (int state = 0; state < states_number; state++) {
+			for (int to : subsets.get(get_image(term, state))) {
+				ss << automaton.get_states()[state].identifier << "	->	"
+				   << automaton.get_states()[to].identifier << "\n";
+			}
 		}
 	}
 	return ss.str();
@@ -281,11 +347,13 @@ string TransformationMonoid::get_equalence_classes_txt() {
 
 map<string, vector<string>> TransformationMonoid::get_equalence_classes_map() {
 	map<string, vector<string>> ss;
-	for (auto& i : terms) {
-		string term = Symbol::vector_to_str(i.name);
-		for (int j = 0; j < i.transitions.size(); j++) {
-			ss[term].push_back(automaton.get_states()[i.transitions[j].first].identifier);
-			ss[term].push_back(automaton.get_states()[i.transitions[j].second].identifier);
+	for (int term = 0; term < terms.size(); term++) {
+		string name = Symbol::vector_to_str(get_name(term));
+		for (int state = 0; state < states_number; state++) {
+			for (int to : subsets.get(get_image(term, state))) {
+				ss[name].push_back(automaton.get_states()[state].identifier);
+				ss[name].push_back(automaton.get_states()[to].identifier);
+			}
 		}
 	}
 	return ss;
@@ -305,113 +373,38 @@ string TransformationMonoid::get_rewriting_rules_txt(iLogTemplate* log) {
 	return ss.str();
 }
 
-vector<TransformationMonoid::Term> TransformationMonoid::get_equalence_classes_vw(const Term& w) {
-	vector<Term> out;
-	for (auto& term : terms) {
-		set<TransformationMonoid::Transition> transitions;
-		for (auto& j : term.transitions) {
-			for (auto transition : w.transitions) {
-				if (j.second == transition.first) {
-					Transition new_transition;
-					new_transition.second = transition.second;
-					new_transition.first = j.first;
-					transitions.insert(new_transition);
-				}
-			}
-		}
-		if (!transitions.empty()) {
-			for (TransformationMonoid::Transition tr : transitions) {
-				if (automaton.get_states()[(tr).second].is_terminal &&
-					(tr).first == automaton.get_initial_state()) {
-					out.push_back(term);
-				}
-			}
-		}
-	}
+// терм входит в ответ столько раз, сколько пар (начальное, финальное) в отношении произведения
+vector<int> TransformationMonoid::get_equalence_classes_vw(int w) {
+	vector<int> out;
+	for (int term = 0; term < terms.size(); term++)
+		out.insert(out.end(), count_final_pairs({term, w}), term);
 	return out;
 }
 
-vector<TransformationMonoid::Term> TransformationMonoid::get_equalence_classes_wv(const Term& w) {
-	vector<Term> out;
-	for (auto& term : terms) {
-		set<TransformationMonoid::Transition> transitions;
-		for (auto& j : term.transitions) {
-			for (auto transition : w.transitions) {
-				if (j.first == transition.second) {
-					Transition new_transition;
-					new_transition.first = transition.first;
-					new_transition.second = j.second;
-					transitions.insert(new_transition);
-				}
-			}
-		}
-		if (!transitions.empty()) {
-			for (const TransformationMonoid::Transition& tr : transitions) {
-				if (automaton.get_states()[(tr).second].is_terminal &&
-					(tr).first == automaton.get_initial_state()) {
-					out.push_back(term);
-				}
-			}
-		}
-	}
+vector<int> TransformationMonoid::get_equalence_classes_wv(int w) {
+	vector<int> out;
+	for (int term = 0; term < terms.size(); term++)
+		out.insert(out.end(), count_final_pairs({w, term}), term);
 	return out;
 }
 
-bool TransformationMonoid::was_transition(const set<TransformationMonoid::Transition>& mas,
-										  const TransformationMonoid::Transition& b) {
-	for (const TransformationMonoid::Transition& maselem : mas) { // TODO: переделать плохой нейминг
-		if (((maselem).first == b.first) && ((maselem).second == b.second)) {
-			return true;
-		}
-	}
-	return false;
-}
-
-vector<TransformationMonoid::TermDouble> TransformationMonoid::get_equalence_classes_vwv(
-	const Term& w) {
-	vector<TermDouble> out;
-	for (auto& i1 : terms) {
-		for (auto& i2 : terms) {
-			// vector<MFATransition> transitions;
-			set<TransformationMonoid::Transition> transitions;
-			for (auto& j1 : i1.transitions) {
-				for (auto& j2 : i2.transitions) {
-					for (auto k : w.transitions) {
-						if ((j1.second == k.first) && (k.second == j2.first)) {
-							Transition new_transition;
-							new_transition.first = j1.first;
-							new_transition.second = j2.second;
-							if (!was_transition(transitions, new_transition)) {
-								transitions.insert(new_transition);
-							}
-						}
-					}
-				}
-			}
-			if (!transitions.empty()) {
-				for (const TransformationMonoid::Transition& tr : transitions) {
-					if (automaton.get_states()[(tr).second].is_terminal &&
-						(tr).first == automaton.get_initial_state()) {
-						TermDouble new_transition_double;
-						new_transition_double.first = i1;
-						new_transition_double.second = i2;
-						out.push_back(new_transition_double);
-					}
-				}
-			}
-		}
-	}
+vector<std::pair<int, int>> TransformationMonoid::get_equalence_classes_vwv(int w) {
+	vector<std::pair<int, int>> out;
+	for (int first = 0; first < terms.size(); first++)
+		for (int second = 0; second < terms.size(); second++)
+			out.insert(out.end(), count_final_pairs({first, w, second}), {first, second});
 	return out;
 }
 
-int TransformationMonoid::is_synchronized(const Term& w) {
-	if (w.transitions.size() == 0) {
-		return -1;
-	}
-	int state = w.transitions[0].second;
-	for (int i = 1; i < w.transitions.size(); i++) {
-		if (w.transitions[i].second != state) {
-			return -1;
+int TransformationMonoid::is_synchronized(int w) {
+	// все переходы терма ведут в одно состояние
+	int state = -1;
+	for (int from = 0; from < states_number; from++) {
+		for (int to : subsets.get(get_image(w, from))) {
+			if (state != -1 && to != state) {
+				return -1;
+			}
+			state = to;
 		}
 	}
 	return state;
@@ -432,12 +425,12 @@ int TransformationMonoid::class_length(iLogTemplate* log) {
 	if (log)
 		log->set_parameter("oldautomaton", automaton.make_fa());
 	if (log) {
-		log->set_parameter("result", to_string(terms[terms.size() - 1].name.size()));
+		log->set_parameter("result", to_string(terms[terms.size() - 1].length));
 		// TODO: logs
 		log->set_parameter("One of the longest words",
-						   Symbol::vector_to_str(terms[terms.size() - 1].name));
+						   Symbol::vector_to_str(get_name(terms.size() - 1)));
 	}
-	return terms[terms.size() - 1].name.size();
+	return terms[terms.size() - 1].length;
 }
 
 int TransformationMonoid::get_classes_number_MyhillNerode(iLogTemplate* log) {
@@ -464,35 +457,26 @@ int TransformationMonoid::get_classes_number_MyhillNerode(iLogTemplate* log) {
 
 bool TransformationMonoid::is_minimal(iLogTemplate* log) {
 	// временные данные
-	vector<Term> table_classes;
+	vector<int> table_classes;
 	vector<vector<bool>> equivalence_classes_table_temp;
 	if (trap_not_minimal) {
 		return false;
 	}
 	if (equivalence_classes_table_bool.empty()) {
-		map<vector<Symbol>, int> data; // храним ссылку на Терм (быстрее и проще искать)
-		for (int i = 0; i < terms.size(); i++) {
-			data[terms[i].name] = i;
-		}
-		int sizetable = 0;
 		set<int> templeft;
-		for (auto& term : terms) {
-			if (term.isFinal) {
-				templeft.insert(data[term.name]);
+		for (int term = 0; term < terms.size(); term++) {
+			if (terms[term].isFinal) {
+				templeft.insert(term);
 			}
-			vector<Term> cur = get_equalence_classes_vw(term);
-			for (auto& j : cur) {
-				templeft.insert(data[j.name]);
-				// table_classes.insert(cur[j]);
+			for (int j : get_equalence_classes_vw(term)) {
+				templeft.insert(j);
 			}
 		}
-		for (int i : templeft) {
-			table_classes.push_back(terms[i]);
-		}
-		map<vector<Symbol>, int> data_table; // храним ссылку на Терм из таблицы М-Н
-											 // (быстрее и проще искать)
+		table_classes.assign(templeft.begin(), templeft.end());
+		// номер строки таблицы М-Н для терма
+		vector<int> data_table(terms.size(), -1);
 		for (int i = 0; i < table_classes.size(); i++) {
-			data_table[table_classes[i].name] = i;
+			data_table[table_classes[i]] = i;
 		}
 		for (int i = 0; i <= table_classes.size(); i++) { // заполняем матрицу нулями
 			vector<bool> vector_first(terms.size() + 1);
@@ -504,7 +488,7 @@ bool TransformationMonoid::is_minimal(iLogTemplate* log) {
 			equivalence_classes_table_temp[0][0] = true;
 		}
 		for (int i = 0; i < table_classes.size(); i++) {
-			if (table_classes[i].isFinal) {
+			if (terms[table_classes[i]].isFinal) {
 				equivalence_classes_table_temp[i + 1][0] = true;
 			}
 		}
@@ -514,9 +498,8 @@ bool TransformationMonoid::is_minimal(iLogTemplate* log) {
 			}
 		}
 		for (int i = 0; i < terms.size(); i++) {
-			vector<Term> cur = get_equalence_classes_vw(terms[i]);
-			for (auto& j : cur) {
-				equivalence_classes_table_temp[data_table.at(j.name) + 1][i + 1] = true;
+			for (int j : get_equalence_classes_vw(i)) {
+				equivalence_classes_table_temp[data_table[j] + 1][i + 1] = true;
 			}
 		}
 
@@ -529,13 +512,13 @@ bool TransformationMonoid::is_minimal(iLogTemplate* log) {
 					equivalence_classes_table_left.push_back(" ");
 				} else {
 					equivalence_classes_table_left.push_back(
-						Symbol::vector_to_str(table_classes[i - 1].name));
+						Symbol::vector_to_str(get_name(table_classes[i - 1])));
 				}
 			}
 		}
 		equivalence_classes_table_top.push_back(" ");
-		for (auto& term : terms) {
-			equivalence_classes_table_top.push_back(Symbol::vector_to_str(term.name));
+		for (int term = 0; term < terms.size(); term++) {
+			equivalence_classes_table_top.push_back(Symbol::vector_to_str(get_name(term)));
 		}
 		// проходим по таблице и удаляем одинаковые столбцы
 		vector<int> delete_column_index;
@@ -575,7 +558,7 @@ string TransformationMonoid::to_txt_MyhillNerode() {
 	}
 	stringstream ss;
 	// iLogTemplate::Table t;
-	int maxlen = terms[terms.size() - 1].name.size();
+	int maxlen = terms[terms.size() - 1].length;
 	ss << string(maxlen + 2, ' ');
 	for (auto& i : equivalence_classes_table_top) {
 		ss << i << string(maxlen + 2 - i.size(), ' ');